@@ -4,16 +4,57 @@ strategy = "MaCross"
 -- Path to the parameters file for the strategy.
 strategyParams = "data/params/MaCross-backtest.lua"
 
+-- Comma separated paths of shared libraries registering more strategies (empty for none).
+strategyPlugins = ""
+
 -- Ask user confirmation before launching the backtest.
 confirmLaunch = true
 
 -- If false, only the start parameters will be used with one thread.
 optimizationMode = false
 
--- What paramters generator to use ("genetic" coming later) (optmization mode only).
--- Choices: "complete"
+-- What paramters generator to use (optmization mode only).
+-- Choices: "complete" (every combination), "genetic" (genetic algorithm, far fewer backtests),
+-- "random" (uniform sampling), "lhs" (Latin hypercube sampling, spread over the whole grid),
+-- "halving" (successive halving of random candidates on growing parts of the history),
+-- "surrogate" (Gaussian process model of the scores, for slow strategies),
+-- "local" (local search refining the best point, declare a fine grid)
 paramsGenerator = "complete"
 
+-- Random, lhs, halving, surrogate and local generators: number of distinct parameters to test.
+paramsBudget = 100
+
+-- Halving generator: the first rung tests the candidates on the first halvingMinHistory percent
+-- of the history, each following rung keeps the best 1/halvingRate of them on halvingRate times
+-- more history.
+halvingRate = 3
+halvingMinHistory = 10
+
+-- Surrogate generator: number of Latin hypercube points tested before using the model.
+surrogateInitial = 20
+
+-- Surrogate generator: number of points tested at the same time once using the model (0 for the
+-- number of threads, or for distributedBatchSize in coordinator mode: set it to the total number
+-- of worker threads so that no worker waits). Checkpoints are not supported with this generator.
+surrogateParallel = 0
+
+-- Local generator: number of Latin hypercube points the search starts from the best of (0 to
+-- start from the start values).
+localInitial = 0
+
+-- Genetic generator: individuals per generation and number of generations.
+geneticPopulation = 50
+geneticGenerations = 20
+
+-- Genetic generator: individuals competing for each parent, probability of a crossover between
+-- two parents, and probability of a mutation of each parameter of a child.
+geneticTournament = 3
+geneticCrossover = 0.9
+geneticMutation = 0.1
+
+-- Seed of the genetic, random, lhs, halving, surrogate and local generators (0 for a different seed on each run).
+paramsSeed = 0
+
 -- How to sort the results and find the best generated parameters.
 -- Choices: "profit"
 resultRanking = "profit"
@@ -24,6 +65,10 @@ showTradeDetails = true
 -- If true, log every trade action in real time (buy/sell/adjust/close).
 showTradeActions = true
 
+-- Number of finished parameters between two progress lines (optimization mode only, 1 also logs
+-- the result and the parameters of each report).
+progressInterval = 10
+
 -- Number of threads used for the test (optimization mode only).
 threads = 3
 
@@ -49,6 +94,76 @@ minPriceOffset = 5
 -- true -> Simple and faster tick generation (up to 4 per 1-minute bar).
 fewerTicks = false
 
+-- Columnar binary file receiving the results of every successful report ("" to disable).
+-- Only the 10 best reports are logged.
+resultsFile = ""
+
+-- Best score for each pair of values of two parameters, for plotting ("" to disable).
+-- Pairs "param1:param2" separated by commas, written to heatmapPrefix-param1-param2.dat.
+heatmaps = ""
+heatmapPrefix = "heatmap"
+
+-- Monte Carlo robustness analysis of the monteCarloTopK best reports: number of runs (0 to disable),
+-- "resample" (trades drawn with replacement) or "shuffle" (trades reordered) runs, and percentage
+-- of the deposit lost for the risk of ruin.
+monteCarloRuns = 1000
+monteCarloTopK = 5
+monteCarloMethod = "resample"
+monteCarloRuin = 50
+
+-- Append the results of finished parameters to this file (optimization mode only, "" to disable).
+checkpointFile = ""
+
+-- Number of finished parameters between two flushes of the checkpoint file.
+checkpointInterval = 10
+
+-- If true, the parameters already finished in checkpointFile are not tested again (refused if the
+-- strategy, the parameters file, the history, the trade settings or the generator settings changed).
+resume = false
+
+-- Results of all the tested parameters, reused by later runs on the same history and setup (optimization mode only, "" to disable).
+resultCacheFile = ""
+
+-- Distributed optimization over sockets (optimization mode only):
+-- "none" -> Local threads only.
+-- "coordinator" -> Generates the parameters and collects the results of the workers (the number of threads is ignored).
+-- "worker" -> Tests the parameters of the coordinator with the local threads (needs the same strategy, history and setup).
+-- The configuration file can be given as first argument: backtester [configuration file]
+distributedMode = "none"
+
+-- Address of the coordinator: "<ip address>:<port>" or "unix:<socket path>".
+distributedEndpoint = "127.0.0.1:5500"
+
+-- Number of parameters sent to a worker at once.
+distributedBatchSize = 10
+
+-- Walk-forward analysis (optimization mode only): the parameters are optimized on in-sample windows
+-- and the best ones of each window are tested on the following out-of-sample days. Each window is
+-- preceded by the minimal number of bars of the strategy (as far as the history goes), which feed the
+-- signal without trading.
+walkForward = false
+
+-- Length in days of the in-sample windows.
+walkForwardInSample = 90
+
+-- Length in days of the out-of-sample windows (and step between two windows).
+walkForwardOutOfSample = 30
+
+-- Pruning: stop testing parameters as soon as they can not be interesting (optimization mode only, 0 to disable).
+-- Pruned results are counted but neither ranked nor stored in the result cache.
+-- Balance below this percentage of the deposit.
+pruneMinBalance = 0
+
+-- Drawdown of the balance above this percentage of its highest value.
+pruneMaxDrawdown = 0
+
+-- Best possible score below the score of the K-th best result (needs pruneMaxLots).
+-- Workers compare to the results of the coordinator, as of their last batch.
+pruneTopK = 0
+
+-- Maximum lots opened by the strategy, used to compute the best possible score.
+pruneMaxLots = 0
+
 -- If true, the 2 plot files will be generated (non-optimization mode only).
 plotOutput = true
 
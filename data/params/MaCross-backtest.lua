@@ -8,6 +8,11 @@ param = {
     macTp =       { start = 18,      step = 0,      iterations = 1   }
 }
 
+-- Constraints on the float parameters (Lua expressions), combinations not satisfying them are not tested
+constraint = {
+    "macFastMa < macSlowMa"
+}
+
 -- String parameters
 string = {
     -- MaCross (signal)
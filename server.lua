@@ -29,6 +29,9 @@ strategy = "MaCross"
 -- Path to the configuration file of the strategy (StratParamsConf).
 strategyParams = "data/params/MaCross.lua"
 
+-- Comma separated paths of shared libraries registering more strategies (empty for none).
+strategyPlugins = ""
+
 -- Print packet data to std out.
 logPackets = true
 
@@ -27,23 +27,32 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <limits>
 #include "Backtester.hpp"
 #include "Logger.hpp"
 #include "tools/ToString.hpp"
-#include "ParamsGeneratorComplete.hpp"
 #include "ParamsGeneratorBase.hpp"
 #include "Conf.hpp"
 #include "Thread.hpp"
 #include "StratParamsMap.hpp"
 #include "ReportManager.hpp"
+#include "ResultRanking.hpp"
 #include "Report.hpp"
+#include "Checkpoint.hpp"
+#include "ResultCache.hpp"
+#include "Coordinator.hpp"
+#include "Worker.hpp"
+#include "WalkForward.hpp"
+#include "core/History.hpp"
+#include "tools/Hash.hpp"
 
 #define CLASS "[Backtester/Backtester] "
 
 namespace Backtester
 {
     Backtester::Backtester(Logger const& logger, Conf& conf, Core::History& history) :
-        _logger(logger), _conf(conf), _history(history), _nbFinishedTasks(0)
+        _logger(logger), _conf(conf), _history(history), _checkpoint(0), _resultCache(0), _worker(0), _walkForward(0), _nbGeneratedTasks(0), _nbFinishedTasks(0), _nbRestoredTasks(0),
+        _scoreThreshold(-std::numeric_limits<float>::infinity())
     {
         this->_paramsGenerator = this->_ParamsGeneratorFactory(this->_conf.paramsGenerator);
         this->_reportManager = new ReportManager(this->_logger, this->_conf);
@@ -51,6 +60,10 @@ namespace Backtester
 
     Backtester::~Backtester()
     {
+        delete this->_walkForward;
+        delete this->_worker;
+        delete this->_resultCache;
+        delete this->_checkpoint;
         delete this->_reportManager;
         delete this->_paramsGenerator;
     }
@@ -59,34 +72,120 @@ namespace Backtester
     {
         if (this->_conf.optimizationMode)
         {
-            if (name == "complete")
-                return new ParamsGeneratorComplete(this->_logger, this->_conf);
-            else
-                this->_logger.Log(CLASS "Paramters generator \"" + name + "\" not found, using default \"base\".", ::Logger::Warning);
+            ParamsGeneratorFactory factory = ParamsGeneratorRegistry::GetInstance().Find(name);
+            if (factory)
+                return factory(this->_logger, this->_conf, this->_history);
+            this->_logger.Log(CLASS "Paramters generator \"" + name + "\" not found (available: " + ParamsGeneratorRegistry::GetInstance().GetNamesString() + "), using default \"base\".", ::Logger::Warning);
         }
         return new ParamsGeneratorBase(this->_logger, this->_conf);
     }
 
     bool Backtester::GetNewParamsFromThread(StratParamsMap& params)
+    {
+        if (this->_worker)
+        {
+            params.Reset();
+            return this->_worker->GetNewParams(params);
+        }
+        return this->GetNewParams(params, true) == ParamsReady;
+    }
+
+    Backtester::ParamsStatus Backtester::GetNewParams(StratParamsMap& params, bool wait)
     {
         params.Reset();
-        std::lock_guard<std::mutex> lock(this->_mutex);
-        return this->_paramsGenerator->GenerateNextParams(params);
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        while (true)
+        {
+            ParamsStatus status = this->_GenerateParams(params);
+            if (status != ParamsWait || !wait)
+                return status;
+            // the next parameters depend on the reports of running tasks
+            this->_reportSubmitted.wait(lock);
+        }
+    }
+
+    // must be called with the mutex locked
+    Backtester::ParamsStatus Backtester::_GenerateParams(StratParamsMap& params)
+    {
+        while (this->_walkForward ? this->_walkForward->GenerateNextParams(params) : this->_paramsGenerator->GenerateNextParams(params))
+        {
+            ++this->_nbGeneratedTasks;
+            if (!this->_RestoreReport(params))
+                return ParamsReady;
+            params.Reset();
+        }
+        if (this->_walkForward ? this->_walkForward->IsWaitingForReports() : this->_paramsGenerator->IsWaitingForReports())
+            return ParamsWait;
+        return ParamsFinished;
+    }
+
+    unsigned int Backtester::_GetNbTotalTasks() const
+    {
+        if (this->_walkForward)
+            return this->_walkForward->GetNbTotalTasks();
+        return this->_paramsGenerator->GetNbTotalTasks();
+    }
+
+    // must be called with the mutex locked
+    bool Backtester::_RestoreReport(StratParamsMap const& params)
+    {
+        if (!this->_checkpoint && !this->_resultCache)
+            return false;
+        Report report(this->_logger);
+        report.CopyParamsFrom(params);
+        // finished before the interruption of a previous run
+        bool restored = this->_checkpoint && this->_checkpoint->IsFinished(params.GetId()) && this->_checkpoint->Restore(params.GetId(), report);
+        // tested by any previous run
+        if (!restored && this->_resultCache && this->_resultCache->Find(params, report))
+        {
+            restored = true;
+            if (this->_checkpoint)
+                this->_checkpoint->Save(report);
+        }
+        if (!restored)
+            return false;
+        ++this->_nbRestoredTasks;
+        this->_SubmitReport(report);
+        return true;
     }
 
     void Backtester::SubmitReportFromThread(Report const& report)
     {
+        if (this->_worker)
+        {
+            // ranked by the coordinator
+            this->_worker->SubmitReport(report);
+            std::lock_guard<std::mutex> lock(this->_mutex);
+            ++this->_nbFinishedTasks;
+            if (this->_nbFinishedTasks % this->_conf.progressInterval == 0)
+                this->_logger.Log(CLASS "Task " + Tools::ToString(this->_nbFinishedTasks) + " report (" + (report.HasFailed() ? "failed" : report.IsPruned() ? "pruned" : "success") + ", " +
+                        Tools::ToString(report.GetTrades().size()) + " trades) sent to the coordinator.");
+            return;
+        }
         std::lock_guard<std::mutex> lock(this->_mutex);
+        if (this->_checkpoint)
+            this->_checkpoint->Save(report);
+        if (this->_resultCache && !report.HasFailed() && !report.IsPruned()) // pruning depends on the other results
+            this->_resultCache->Store(report);
+        this->_SubmitReport(report);
+        this->_reportSubmitted.notify_all();
+    }
+
+    // must be called with the mutex locked
+    void Backtester::_SubmitReport(Report const& report)
+    {
         ++this->_nbFinishedTasks;
-        this->_logger.Log(CLASS "Task " + Tools::ToString(this->_nbFinishedTasks) + " report (" + (report.HasFailed() ? "failed" : "success") + ", " +
-                Tools::ToString(report.GetTrades().size()) + " trades) with " + report.GetParams().GetFloatParamsString());
-        unsigned int totalTasks = this->_paramsGenerator->GetNbTotalTasks();
+        // one line per report would slow the threads down on fast strategies
+        if (this->_conf.progressInterval == 1)
+            this->_logger.Log(CLASS "Task " + Tools::ToString(this->_nbFinishedTasks) + " report (" + (report.HasFailed() ? "failed" : report.IsPruned() ? "pruned" : "success") + ", " +
+                    Tools::ToString(report.GetTrades().size()) + " trades) with " + report.GetParams().GetFloatParamsString());
+        unsigned int totalTasks = this->_GetNbTotalTasks();
         if (this->_nbFinishedTasks >= totalTasks)
             this->_logger.Log(CLASS "Task " + Tools::ToString(this->_nbFinishedTasks) + " finished.");
-        else
+        else if (this->_nbFinishedTasks > this->_nbRestoredTasks && this->_nbFinishedTasks % this->_conf.progressInterval == 0)
         {
             int tasksLeft = totalTasks - this->_nbFinishedTasks;
-            long time = this->_timer.ElapsedMs() / this->_nbFinishedTasks; // time per task
+            long time = this->_timer.ElapsedMs() / (this->_nbFinishedTasks - this->_nbRestoredTasks); // time per computed task
             time *= (tasksLeft > 0 ? tasksLeft : 0); // time for all the left tasks
             time /= 1000; // in seconds
             unsigned int hours = time / 3600;
@@ -96,11 +195,61 @@ namespace Backtester
                     (totalTasks ? Tools::ToString(totalTasks) : "?") + " finished. Estimated time left: " +
                     Tools::ToString(hours) + "h " + Tools::ToString(minutes) + "m " + Tools::ToString(seconds) + "s.");
         }
-        this->_reportManager->AddReport(report);
+        if (this->_walkForward)
+        {
+            this->_walkForward->AddReport(report);
+            return;
+        }
+        if (report.GetParams().GetHistoryBegin() || report.GetParams().GetHistoryEnd())
+        {
+            // part of the history: only ranked for the generator
+            Report partial(this->_logger);
+            partial.CopyDataFrom(report);
+            if (!partial.HasFailed() && !partial.IsPruned())
+                partial.SetScore(this->_reportManager->GetResultRanking().Rank(partial));
+            this->_paramsGenerator->ReportFeedback(partial);
+            return;
+        }
+        this->_paramsGenerator->ReportFeedback(this->_reportManager->AddReport(report));
+        this->_scoreThreshold = this->_reportManager->GetScoreThreshold();
+    }
+
+    float Backtester::GetScoreThreshold() const
+    {
+        if (this->_worker)
+            return this->_worker->GetScoreThreshold();
+        return this->_scoreThreshold;
+    }
+
+    ResultRanking const& Backtester::GetResultRanking() const
+    {
+        return this->_reportManager->GetResultRanking();
     }
 
     void Backtester::Run()
     {
+        // same key on the coordinator and its workers
+        Tools::Hash setupKey;
+        setupKey.Add(this->_conf.GetTradesHash()).Add(this->_history.GetFingerprint());
+        // pruned reports are final results
+        setupKey.Add(this->_conf.pruneMinBalance)
+            .Add(this->_conf.pruneMaxDrawdown)
+            .Add(this->_conf.pruneTopK)
+            .Add(this->_conf.pruneMaxLots);
+
+        // parameters come from the coordinator
+        if (this->_conf.distributedMode == "worker")
+        {
+            this->_worker = new Worker(this->_logger, this->_conf, setupKey.GetValue());
+            if (!this->_worker->Connect())
+            {
+                this->_logger.Log(CLASS "Worker initialization failed.", ::Logger::Error);
+                return;
+            }
+            this->_RunThreads();
+            return;
+        }
+
         // initialize parameter generator
         if (!this->_paramsGenerator->ProcessFile(this->_conf.strategyParams))
         {
@@ -113,38 +262,104 @@ namespace Backtester
             return;
         }
 
-        // create threads
-        std::vector<Thread*> threads;
-        for (unsigned int i = 0; i < this->_conf.threads; ++i)
-            threads.push_back(new Thread(i + 1, this->_conf, this->_history, *this));
+        // split the history in windows
+        if (this->_conf.walkForward)
+        {
+            this->_walkForward = new WalkForward(this->_logger, this->_conf, this->_history, *this->_paramsGenerator, this->_reportManager->GetResultRanking());
+            if (!this->_walkForward->Initialize())
+            {
+                this->_logger.Log(CLASS "Walk-forward initialization failed.", ::Logger::Error);
+                return;
+            }
+        }
+
+        // open checkpoint file
+        if (this->_conf.optimizationMode && !this->_conf.checkpointFile.empty())
+        {
+            this->_checkpoint = new Checkpoint(this->_logger, this->_conf);
+            if (!this->_checkpoint->Open(this->_paramsGenerator->GetName(), this->_paramsGenerator->GetNbTotalTasks(), setupKey.GetValue()))
+            {
+                this->_logger.Log(CLASS "Checkpoint initialization failed.", ::Logger::Error);
+                return;
+            }
+        }
+
+        // open result cache
+        if (this->_conf.optimizationMode && !this->_conf.resultCacheFile.empty())
+        {
+            this->_resultCache = new ResultCache(this->_logger, this->_conf, this->_history);
+            if (!this->_resultCache->Open())
+            {
+                this->_logger.Log(CLASS "Result cache initialization failed.", ::Logger::Error);
+                return;
+            }
+        }
 
         // log recap
         this->_logger.Log(CLASS + std::string("Optimization mode: ") + (this->_conf.optimizationMode ? "enabled" : "disabled (one thread)") + ".");
         if (this->_conf.optimizationMode)
         {
-            if (this->_paramsGenerator->GetNbTotalTasks())
-                this->_logger.Log(CLASS "Estimated number of tasks: " + Tools::ToString(this->_paramsGenerator->GetNbTotalTasks()) + " (" +
-                        Tools::ToString(this->_conf.threads) + " thread" + (this->_conf.threads > 1 ? "s" : "") + ", ~" +
-                        Tools::ToString(static_cast<float>(this->_paramsGenerator->GetNbTotalTasks()) / static_cast<float>(this->_conf.threads), 1) + " tasks per thread).");
+            if (this->_GetNbTotalTasks())
+                this->_logger.Log(CLASS "Estimated number of tasks: " + Tools::ToString(this->_GetNbTotalTasks()) +
+                        (this->_conf.distributedMode == "coordinator" ? std::string(" (distributed to workers).") :
+                        " (" + Tools::ToString(this->_conf.threads) + " thread" + (this->_conf.threads > 1 ? "s" : "") + ", ~" +
+                        Tools::ToString(static_cast<float>(this->_GetNbTotalTasks()) / static_cast<float>(this->_conf.threads), 1) + " tasks per thread)."));
             else
                 this->_logger.Log(CLASS "Unknown number of tasks.", ::Logger::Warning);
         }
 
-        // ask user confirmation
-        if (this->_conf.confirmLaunch)
+        if (this->_conf.distributedMode == "coordinator")
         {
-            this->_logger.Log(CLASS "Proceed [Y/n]? ");
-            int c = getchar();
-            if (c == 'n' || c == 'N')
+            if (!this->_Confirm())
+                return;
+            this->_timer.Reset();
+            Coordinator coordinator(this->_logger, this->_conf, *this, setupKey.GetValue());
+            if (!coordinator.Run())
             {
-                this->_logger.Log(CLASS "Abort.", ::Logger::Error);
-                std::vector<Thread*>::iterator it = threads.begin();
-                std::vector<Thread*>::iterator itEnd = threads.end();
-                for (; it != itEnd; ++it)
-                    delete *it;
+                this->_logger.Log(CLASS "Coordinator failed.", ::Logger::Error);
                 return;
             }
         }
+        else
+            this->_RunThreads();
+
+        if (this->_checkpoint)
+            this->_checkpoint->Flush();
+        if (this->_resultCache)
+            this->_resultCache->Flush();
+
+        // show results
+        if (this->_walkForward)
+            this->_walkForward->AddResults(*this->_reportManager);
+        if (!this->_conf.optimizationMode && this->_conf.showTradeDetails)
+            this->_reportManager->ShowTradeDetails();
+        this->_reportManager->Run();
+    }
+
+    bool Backtester::_Confirm() const
+    {
+        if (!this->_conf.confirmLaunch)
+            return true;
+        this->_logger.Log(CLASS "Proceed [Y/n]? ");
+        int c = getchar();
+        if (c == 'n' || c == 'N')
+        {
+            this->_logger.Log(CLASS "Abort.", ::Logger::Error);
+            return false;
+        }
+        return true;
+    }
+
+    void Backtester::_RunThreads()
+    {
+        // workers run unattended
+        if (!this->_worker && !this->_Confirm())
+            return;
+
+        // create threads
+        std::vector<Thread*> threads;
+        for (unsigned int i = 0; i < this->_conf.threads; ++i)
+            threads.push_back(new Thread(i + 1, this->_conf, this->_history, *this));
 
         // launch threads
         this->_timer.Reset();
@@ -166,10 +381,5 @@ namespace Backtester
                 delete *it;
             }
         }
-
-        // show results
-        if (!this->_conf.optimizationMode && this->_conf.showTradeDetails)
-            this->_reportManager->ShowTradeDetails();
-        this->_reportManager->Run();
     }
 }
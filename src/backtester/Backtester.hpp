@@ -32,6 +32,9 @@
 
 #include <boost/noncopyable.hpp>
 #include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
 #include "tools/Timer.hpp"
 
 namespace Core
@@ -47,6 +50,11 @@ namespace Backtester
     class Report;
     class ReportManager;
     class ParamsGenerator;
+    class ResultRanking;
+    class Checkpoint;
+    class ResultCache;
+    class Worker;
+    class WalkForward;
 
     class Backtester :
         private boost::noncopyable
@@ -56,16 +64,47 @@ namespace Backtester
             ~Backtester();
             void Run();
             bool GetNewParamsFromThread(StratParamsMap& params);
+
+            /*
+               ParamsWait: no parameters until more reports are submitted (only returned if wait is false).
+            */
+            enum ParamsStatus
+            {
+                ParamsReady,
+                ParamsWait,
+                ParamsFinished,
+            };
+            ParamsStatus GetNewParams(StratParamsMap& params, bool wait);
             void SubmitReportFromThread(Report const& report);
+
+            /*
+               Used by the pruning of the threads (without locking).
+            */
+            float GetScoreThreshold() const;
+            ResultRanking const& GetResultRanking() const;
         private:
             ParamsGenerator* _ParamsGeneratorFactory(std::string const& name) const;
+            bool _Confirm() const;
+            void _RunThreads();
+            ParamsStatus _GenerateParams(StratParamsMap& params);
+            unsigned int _GetNbTotalTasks() const;
+            bool _RestoreReport(StratParamsMap const& params);
+            void _SubmitReport(Report const& report);
             Logger const& _logger;
             Conf& _conf;
             Core::History& _history;
             std::mutex _mutex;
+            std::condition_variable _reportSubmitted;
             ReportManager* _reportManager;
             ParamsGenerator* _paramsGenerator;
+            Checkpoint* _checkpoint;
+            ResultCache* _resultCache;
+            Worker* _worker;
+            WalkForward* _walkForward;
+            unsigned int _nbGeneratedTasks;
             unsigned int _nbFinishedTasks;
+            unsigned int _nbRestoredTasks;
+            std::atomic<float> _scoreThreshold;
             Tools::Timer _timer;
     };
 }
@@ -0,0 +1,198 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <sstream>
+#include "Checkpoint.hpp"
+#include "Logger.hpp"
+#include "Report.hpp"
+#include "Conf.hpp"
+#include "tools/ToString.hpp"
+#include "tools/Hash.hpp"
+
+#define CLASS "[Backtester/Checkpoint] "
+
+/*
+   File format (one record per line, append-only):
+     # open-trading checkpoint <version> <strategy> <generator> <tasks> <setup hash in hexadecimal>
+     r <parameters id> <serialized report>
+   A line cut by a kill is ignored when resuming.
+*/
+
+namespace Backtester
+{
+    Checkpoint::Checkpoint(Logger const& logger, Conf const& conf) :
+        _logger(logger), _conf(conf), _unflushed(0)
+    {
+    }
+
+    Checkpoint::~Checkpoint()
+    {
+        if (this->_file.is_open())
+            this->Flush();
+    }
+
+    std::string Checkpoint::_Header(std::string const& generator, unsigned int nbTotalTasks, boost::uint64_t setupKey) const
+    {
+        // the ids only designate the same parameters with the same ranges and generator settings
+        Tools::Hash h;
+        h.Add(setupKey);
+        {
+            std::ifstream f(this->_conf.strategyParams.c_str());
+            std::string line;
+            while (std::getline(f, line))
+                h.Add(line);
+        }
+        h.Add(this->_conf.paramsSeed)
+            .Add(this->_conf.paramsBudget)
+            .Add(this->_conf.geneticPopulation)
+            .Add(this->_conf.geneticGenerations)
+            .Add(this->_conf.geneticTournament)
+            .Add(this->_conf.geneticCrossover)
+            .Add(this->_conf.geneticMutation)
+            .Add(this->_conf.halvingRate)
+            .Add(this->_conf.halvingMinHistory)
+            .Add(this->_conf.localInitial);
+        std::ostringstream key;
+        key << std::hex << h.GetValue();
+        return "# open-trading checkpoint 1 " + this->_conf.strategy + " " + generator + " " + Tools::ToString(nbTotalTasks) + " " + key.str();
+    }
+
+    bool Checkpoint::Open(std::string const& generator, unsigned int nbTotalTasks, boost::uint64_t setupKey)
+    {
+        std::string header = this->_Header(generator, nbTotalTasks, setupKey);
+        bool append = false;
+        if (this->_conf.resume)
+        {
+            std::ifstream f(this->_conf.checkpointFile.c_str());
+            if (f.good())
+            {
+                if (!this->_Load(header))
+                    return false;
+                append = true;
+            }
+            else
+                this->_logger.Log(CLASS "No checkpoint file \"" + this->_conf.checkpointFile + "\" to resume from, starting from scratch.", ::Logger::Warning);
+        }
+        if (append)
+            this->_file.open(this->_conf.checkpointFile.c_str(), std::ios::out | std::ios::app);
+        else
+            this->_file.open(this->_conf.checkpointFile.c_str(), std::ios::out | std::ios::trunc);
+        if (!this->_file.good())
+        {
+            this->_logger.Log(CLASS "Failed to open checkpoint file \"" + this->_conf.checkpointFile + "\".", ::Logger::Error);
+            return false;
+        }
+        if (append)
+            this->_file << std::endl; // the last line may have been cut
+        else
+        {
+            this->_file << header << std::endl;
+            this->_logger.Log(CLASS "Writing checkpoints to \"" + this->_conf.checkpointFile + "\" every " + Tools::ToString(this->_conf.checkpointInterval) + " reports.");
+        }
+        return true;
+    }
+
+    bool Checkpoint::_Load(std::string const& header)
+    {
+        std::ifstream f(this->_conf.checkpointFile.c_str());
+        std::string line;
+        std::getline(f, line);
+        if (line != header)
+        {
+            this->_logger.Log(CLASS "Checkpoint file \"" + this->_conf.checkpointFile + "\" was written by another run or with other settings (\"" + line + "\", expected \"" + header + "\").", ::Logger::Error);
+            return false;
+        }
+        unsigned int ignored = 0;
+        while (std::getline(f, line))
+        {
+            std::istringstream ss(line);
+            std::string type;
+            if (!(ss >> type))
+                continue; // empty line
+            if (type == "r")
+            {
+                unsigned int id;
+                std::string report;
+                if ((ss >> id) && std::getline(ss, report))
+                {
+                    // check that the record is complete before trusting it
+                    Report dummy(this->_logger);
+                    std::istringstream rs(report);
+                    if (dummy.Unserialize(rs))
+                    {
+                        this->_finished[id] = report;
+                        continue;
+                    }
+                }
+            }
+            ++ignored;
+        }
+        if (ignored)
+            this->_logger.Log(CLASS "Ignored " + Tools::ToString(ignored) + " invalid line" + (ignored > 1 ? "s" : "") + " in checkpoint file.", ::Logger::Warning);
+        this->_logger.Log(CLASS "Resuming from \"" + this->_conf.checkpointFile + "\": " + Tools::ToString(this->_finished.size()) +
+                " finished parameter sets.");
+        return true;
+    }
+
+    bool Checkpoint::IsFinished(unsigned int id) const
+    {
+        return this->_finished.find(id) != this->_finished.end();
+    }
+
+    bool Checkpoint::Restore(unsigned int id, Report& report) const
+    {
+        std::map<unsigned int, std::string>::const_iterator it = this->_finished.find(id);
+        if (it == this->_finished.end())
+            return false;
+        std::istringstream ss(it->second);
+        return report.Unserialize(ss);
+    }
+
+    void Checkpoint::Save(Report const& report)
+    {
+        this->_file << "r " << report.GetParams().GetId() << " ";
+        report.Serialize(this->_file);
+        this->_file << "\n";
+        if (++this->_unflushed >= this->_conf.checkpointInterval)
+            this->Flush();
+    }
+
+    void Checkpoint::Flush()
+    {
+        this->_file.flush();
+        this->_unflushed = 0;
+        if (!this->_file.good())
+            this->_logger.Log(CLASS "Failed to write to checkpoint file \"" + this->_conf.checkpointFile + "\".", ::Logger::Warning);
+    }
+
+    unsigned int Checkpoint::GetNbFinished() const
+    {
+        return this->_finished.size();
+    }
+}
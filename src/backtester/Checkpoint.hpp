@@ -0,0 +1,86 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_CHECKPOINT__
+#define __BACKTESTER_CHECKPOINT__
+
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <fstream>
+#include <map>
+#include <string>
+
+namespace Backtester
+{
+    class Logger;
+    class Conf;
+    class Report;
+
+    class Checkpoint :
+        private boost::noncopyable
+    {
+        public:
+            explicit Checkpoint(Logger const& logger, Conf const& conf);
+            ~Checkpoint();
+
+            /*
+               Opens the checkpoint file for appending.
+               When resuming, the finished reports of a previous run are loaded first. The file header must match the
+               current strategy, parameters generator, number of tasks and a hash of setupKey (trade settings, pruning
+               settings and history), the parameters file and the generator settings, otherwise false is returned.
+               Without resuming, the file is truncated.
+            */
+            bool Open(std::string const& generator, unsigned int nbTotalTasks, boost::uint64_t setupKey);
+
+            bool IsFinished(unsigned int id) const;
+
+            /*
+               Copies the stored results of a finished parameter set to report (parameters are not modified).
+            */
+            bool Restore(unsigned int id, Report& report) const;
+
+            /*
+               Appends a finished report. The file is flushed every checkpointInterval reports.
+            */
+            void Save(Report const& report);
+
+            void Flush();
+            unsigned int GetNbFinished() const;
+        private:
+            bool _Load(std::string const& header);
+            std::string _Header(std::string const& generator, unsigned int nbTotalTasks, boost::uint64_t setupKey) const;
+            Logger const& _logger;
+            Conf const& _conf;
+            std::ofstream _file;
+            std::map<unsigned int, std::string> _finished;
+            unsigned int _unflushed;
+    };
+}
+
+#endif
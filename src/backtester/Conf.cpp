@@ -31,6 +31,7 @@
 #include "conf/Conf.hpp"
 #include "Logger.hpp"
 #include "tools/ToString.hpp"
+#include "tools/Hash.hpp"
 
 #define CLASS "[Backtester/Conf] "
 
@@ -40,6 +41,7 @@ namespace Backtester
     {
         this->strategy = from.Read<std::string>("strategy", "");
         this->strategyParams = from.Read<std::string>("strategyParams", "");
+        this->strategyPlugins = from.Read<std::string>("strategyPlugins", "");
         this->pair = from.Read<std::string>("pair", "");
         if (this->pair.size() != 6)
         {
@@ -87,20 +89,236 @@ namespace Backtester
         this->confirmLaunch = from.Read<bool>("confirmLaunch", true);
         this->showTradeActions = from.Read<bool>("showTradeActions", true);
         this->showTradeDetails = from.Read<bool>("showTradeDetails", true);
+        this->progressInterval = from.Read<unsigned int>("progressInterval", 10);
+        if (this->progressInterval < 1)
+        {
+            logger.Log(CLASS "Invalid progress interval of " + Tools::ToString(this->progressInterval) + ", changing to " + Tools::ToString(10) + ".", ::Logger::Warning);
+            this->progressInterval = 10;
+        }
         this->deposit = from.Read<float>("deposit", 10000);
         this->plotOutput = from.Read<bool>("plotOutput", false);
         this->plotDataFile = from.Read<std::string>("plotDataFile", "backtest.dat");
         this->plotSettingsFile = from.Read<std::string>("plotSettingsFile", "backtest.plot");
+        this->geneticPopulation = from.Read<unsigned int>("geneticPopulation", 50);
+        if (this->geneticPopulation < 2)
+        {
+            logger.Log(CLASS "Invalid genetic population of " + Tools::ToString(this->geneticPopulation) + ", changing to " + Tools::ToString(50) + ".", ::Logger::Warning);
+            this->geneticPopulation = 50;
+        }
+        this->geneticGenerations = from.Read<unsigned int>("geneticGenerations", 20);
+        if (this->geneticGenerations < 1)
+        {
+            logger.Log(CLASS "Invalid genetic generation number of " + Tools::ToString(this->geneticGenerations) + ", changing to " + Tools::ToString(20) + ".", ::Logger::Warning);
+            this->geneticGenerations = 20;
+        }
+        this->geneticTournament = from.Read<unsigned int>("geneticTournament", 3);
+        if (this->geneticTournament < 1 || this->geneticTournament > this->geneticPopulation)
+        {
+            unsigned int tournament = this->geneticPopulation < 3 ? this->geneticPopulation : 3;
+            logger.Log(CLASS "Invalid genetic tournament size of " + Tools::ToString(this->geneticTournament) + ", changing to " + Tools::ToString(tournament) + ".", ::Logger::Warning);
+            this->geneticTournament = tournament;
+        }
+        this->geneticCrossover = from.Read<float>("geneticCrossover", 0.9);
+        if (this->geneticCrossover < 0 || this->geneticCrossover > 1)
+        {
+            logger.Log(CLASS "Invalid genetic crossover rate of " + Tools::ToString(this->geneticCrossover, 2) + ", changing to " + Tools::ToString(0.9, 2) + ".", ::Logger::Warning);
+            this->geneticCrossover = 0.9;
+        }
+        this->geneticMutation = from.Read<float>("geneticMutation", 0.1);
+        if (this->geneticMutation < 0 || this->geneticMutation > 1)
+        {
+            logger.Log(CLASS "Invalid genetic mutation rate of " + Tools::ToString(this->geneticMutation, 2) + ", changing to " + Tools::ToString(0.1, 2) + ".", ::Logger::Warning);
+            this->geneticMutation = 0.1;
+        }
+        this->paramsBudget = from.Read<unsigned int>("paramsBudget", 100);
+        if (this->paramsBudget < 1)
+        {
+            logger.Log(CLASS "Invalid parameters budget of " + Tools::ToString(this->paramsBudget) + ", changing to " + Tools::ToString(100) + ".", ::Logger::Warning);
+            this->paramsBudget = 100;
+        }
+        this->paramsSeed = from.Read<unsigned int>("paramsSeed", 0);
+        this->halvingRate = from.Read<unsigned int>("halvingRate", 3);
+        if (this->halvingRate < 2)
+        {
+            logger.Log(CLASS "Invalid halving rate of " + Tools::ToString(this->halvingRate) + ", changing to " + Tools::ToString(3) + ".", ::Logger::Warning);
+            this->halvingRate = 3;
+        }
+        this->halvingMinHistory = from.Read<float>("halvingMinHistory", 10);
+        if (this->halvingMinHistory <= 0 || this->halvingMinHistory > 100)
+        {
+            logger.Log(CLASS "Invalid halving minimal history of " + Tools::ToString(this->halvingMinHistory, 2) + "%, changing to " + Tools::ToString(10, 2) + "%.", ::Logger::Warning);
+            this->halvingMinHistory = 10;
+        }
+        this->surrogateInitial = from.Read<unsigned int>("surrogateInitial", 20);
+        if (this->surrogateInitial < 1 || this->surrogateInitial > this->paramsBudget)
+        {
+            unsigned int initial = this->paramsBudget < 20 ? this->paramsBudget : 20;
+            logger.Log(CLASS "Invalid surrogate initial points number of " + Tools::ToString(this->surrogateInitial) + ", changing to " + Tools::ToString(initial) + ".", ::Logger::Warning);
+            this->surrogateInitial = initial;
+        }
+        this->surrogateParallel = from.Read<unsigned int>("surrogateParallel", 0);
+        this->localInitial = from.Read<unsigned int>("localInitial", 0);
+        if (this->localInitial > this->paramsBudget)
+        {
+            logger.Log(CLASS "Invalid local search initial points number of " + Tools::ToString(this->localInitial) + ", changing to " + Tools::ToString(this->paramsBudget) + ".", ::Logger::Warning);
+            this->localInitial = this->paramsBudget;
+        }
         this->resultRanking = from.Read<std::string>("resultRanking", "profit");
+        this->resultsFile = from.Read<std::string>("resultsFile", "");
+        this->heatmaps = from.Read<std::string>("heatmaps", "");
+        this->heatmapPrefix = from.Read<std::string>("heatmapPrefix", "heatmap");
         this->fewerTicks = from.Read<bool>("fewerTicks", false);
+        this->checkpointFile = from.Read<std::string>("checkpointFile", "");
+        this->checkpointInterval = from.Read<unsigned int>("checkpointInterval", 10);
+        if (this->checkpointInterval < 1)
+        {
+            logger.Log(CLASS "Invalid checkpoint interval of " + Tools::ToString(this->checkpointInterval) + ", changing to " + Tools::ToString(10) + ".", ::Logger::Warning);
+            this->checkpointInterval = 10;
+        }
+        this->resume = from.Read<bool>("resume", false);
+        this->resultCacheFile = from.Read<std::string>("resultCacheFile", "");
+        this->distributedMode = from.Read<std::string>("distributedMode", "none");
+        if (this->distributedMode != "none" && this->distributedMode != "coordinator" && this->distributedMode != "worker")
+        {
+            logger.Log(CLASS "Invalid distributed mode \"" + this->distributedMode + "\", changing to \"none\".", ::Logger::Warning);
+            this->distributedMode = "none";
+        }
+        if (this->distributedMode != "none" && !this->optimizationMode)
+        {
+            logger.Log(CLASS "Distributed mode \"" + this->distributedMode + "\" needs optimization mode, changing to \"none\".", ::Logger::Warning);
+            this->distributedMode = "none";
+        }
+        this->distributedEndpoint = from.Read<std::string>("distributedEndpoint", "127.0.0.1:5500");
+        this->distributedBatchSize = from.Read<unsigned int>("distributedBatchSize", 10);
+        if (this->distributedBatchSize < 1)
+        {
+            logger.Log(CLASS "Invalid distributed batch size of " + Tools::ToString(this->distributedBatchSize) + ", changing to " + Tools::ToString(10) + ".", ::Logger::Warning);
+            this->distributedBatchSize = 10;
+        }
+        this->pruneMinBalance = from.Read<float>("pruneMinBalance", 0);
+        if (this->pruneMinBalance < 0 || this->pruneMinBalance >= 100)
+        {
+            logger.Log(CLASS "Invalid pruning minimal balance of " + Tools::ToString(this->pruneMinBalance, 2) + "%, disabling.", ::Logger::Warning);
+            this->pruneMinBalance = 0;
+        }
+        this->pruneMaxDrawdown = from.Read<float>("pruneMaxDrawdown", 0);
+        if (this->pruneMaxDrawdown < 0 || this->pruneMaxDrawdown > 100)
+        {
+            logger.Log(CLASS "Invalid pruning maximal drawdown of " + Tools::ToString(this->pruneMaxDrawdown, 2) + "%, disabling.", ::Logger::Warning);
+            this->pruneMaxDrawdown = 0;
+        }
+        this->pruneTopK = from.Read<unsigned int>("pruneTopK", 0);
+        this->pruneMaxLots = from.Read<float>("pruneMaxLots", 0);
+        if (this->pruneTopK && this->pruneMaxLots <= 0)
+        {
+            logger.Log(CLASS "Pruning on the top " + Tools::ToString(this->pruneTopK) + " scores needs pruneMaxLots, disabling.", ::Logger::Warning);
+            this->pruneTopK = 0;
+        }
+        this->monteCarloRuns = from.Read<unsigned int>("monteCarloRuns", 1000);
+        this->monteCarloTopK = from.Read<unsigned int>("monteCarloTopK", 5);
+        if (this->monteCarloTopK < 1)
+        {
+            logger.Log(CLASS "Invalid Monte Carlo report number of " + Tools::ToString(this->monteCarloTopK) + ", changing to " + Tools::ToString(5) + ".", ::Logger::Warning);
+            this->monteCarloTopK = 5;
+        }
+        this->monteCarloMethod = from.Read<std::string>("monteCarloMethod", "resample");
+        if (this->monteCarloMethod != "resample" && this->monteCarloMethod != "shuffle")
+        {
+            logger.Log(CLASS "Invalid Monte Carlo method \"" + this->monteCarloMethod + "\", changing to \"resample\".", ::Logger::Warning);
+            this->monteCarloMethod = "resample";
+        }
+        this->monteCarloRuin = from.Read<float>("monteCarloRuin", 50);
+        if (this->monteCarloRuin <= 0 || this->monteCarloRuin > 100)
+        {
+            logger.Log(CLASS "Invalid Monte Carlo ruin of " + Tools::ToString(this->monteCarloRuin, 2) + "%, changing to " + Tools::ToString(50, 2) + "%.", ::Logger::Warning);
+            this->monteCarloRuin = 50;
+        }
+        this->walkForward = from.Read<bool>("walkForward", false);
+        this->walkForwardInSample = from.Read<unsigned int>("walkForwardInSample", 90);
+        if (this->walkForwardInSample < 1)
+        {
+            logger.Log(CLASS "Invalid walk-forward in-sample length of " + Tools::ToString(this->walkForwardInSample) + " days, changing to " + Tools::ToString(90) + ".", ::Logger::Warning);
+            this->walkForwardInSample = 90;
+        }
+        this->walkForwardOutOfSample = from.Read<unsigned int>("walkForwardOutOfSample", 30);
+        if (this->walkForwardOutOfSample < 1)
+        {
+            logger.Log(CLASS "Invalid walk-forward out-of-sample length of " + Tools::ToString(this->walkForwardOutOfSample) + " days, changing to " + Tools::ToString(30) + ".", ::Logger::Warning);
+            this->walkForwardOutOfSample = 30;
+        }
+        if (this->walkForward && !this->optimizationMode)
+        {
+            logger.Log(CLASS "Walk-forward needs optimization mode, disabling.", ::Logger::Warning);
+            this->walkForward = false;
+        }
+        if (this->walkForward && this->paramsGenerator == "halving")
+        {
+            // both choose the history range of the tasks
+            logger.Log(CLASS "Walk-forward does not support the halving generator, disabling.", ::Logger::Warning);
+            this->walkForward = false;
+        }
+        if (this->walkForward && !this->checkpointFile.empty())
+        {
+            // several reports per parameters id
+            logger.Log(CLASS "Checkpoints are not supported in walk-forward mode, disabling.", ::Logger::Warning);
+            this->checkpointFile = "";
+        }
+        if (this->paramsGenerator == "surrogate" && !this->checkpointFile.empty())
+        {
+            // the proposals depend on the order of the reports, a resumed run would give the old reports to other parameters
+            logger.Log(CLASS "Checkpoints are not supported with the surrogate generator, disabling.", ::Logger::Warning);
+            this->checkpointFile = "";
+        }
+        if (!this->surrogateParallel)
+        {
+            // the coordinator does not know how many threads its workers run
+            this->surrogateParallel = this->distributedMode == "coordinator" ? this->distributedBatchSize : this->threads;
+        }
+        if (this->IsRandomParamsGenerator() && !this->paramsSeed && !this->checkpointFile.empty())
+        {
+            // the ids of a random run do not match the ids of the previous one
+            logger.Log(CLASS "Checkpoints need a fixed paramsSeed with the \"" + this->paramsGenerator + "\" generator, disabling.", ::Logger::Warning);
+            this->checkpointFile = "";
+        }
+        if (!this->optimizationMode)
+        {
+            // a single backtest always runs to the end
+            this->pruneMinBalance = 0;
+            this->pruneMaxDrawdown = 0;
+            this->pruneTopK = 0;
+        }
         this->_Dump(logger);
     }
 
+    boost::uint64_t Conf::GetTradesHash() const
+    {
+        Tools::Hash h;
+        h.Add(this->strategy)
+            .Add(this->pair)
+            .Add(this->period)
+            .Add(this->digits)
+            .Add(this->spread)
+            .Add(this->minPriceOffset)
+            .Add(this->fewerTicks);
+        return h.GetValue();
+    }
+
+    bool Conf::IsRandomParamsGenerator() const
+    {
+        return this->paramsGenerator == "genetic" || this->IsBudgetParamsGenerator();
+    }
+
+    bool Conf::IsBudgetParamsGenerator() const
+    {
+        return this->paramsGenerator == "random" || this->paramsGenerator == "lhs" || this->paramsGenerator == "halving" || this->paramsGenerator == "surrogate" || this->paramsGenerator == "local";
+    }
+
     void Conf::_Dump(Logger const& logger)
     {
         logger.Log(CLASS "Configuration dump:");
         logger.Log(CLASS "  - strategy: \"" + this->strategy + "\"");
         logger.Log(CLASS "  - strategyParams: \"" + this->strategyParams + "\"");
+        logger.Log(CLASS "  - strategyPlugins: \"" + this->strategyPlugins + "\"");
         logger.Log(CLASS "  - pair: \"" + this->pair + "\"");
         logger.Log(CLASS "  - baseCurrency: \"" + this->baseCurrency + "\"");
         logger.Log(CLASS "  - counterCurrency: \"" + this->counterCurrency + "\"");
@@ -115,5 +333,73 @@ namespace Backtester
             logger.Log(CLASS "  - plotDataFile: \"" + this->plotDataFile + "\"");
             logger.Log(CLASS "  - plotSettingsFile: \"" + this->plotSettingsFile + "\"");
         }
+        if (this->optimizationMode)
+            logger.Log(CLASS "  - progressInterval: " + Tools::ToString(this->progressInterval));
+        if (this->optimizationMode && this->paramsGenerator == "genetic")
+        {
+            logger.Log(CLASS "  - geneticPopulation: " + Tools::ToString(this->geneticPopulation));
+            logger.Log(CLASS "  - geneticGenerations: " + Tools::ToString(this->geneticGenerations));
+            logger.Log(CLASS "  - geneticTournament: " + Tools::ToString(this->geneticTournament));
+            logger.Log(CLASS "  - geneticCrossover: " + Tools::ToString(this->geneticCrossover, 2));
+            logger.Log(CLASS "  - geneticMutation: " + Tools::ToString(this->geneticMutation, 2));
+        }
+        if (this->optimizationMode && this->IsBudgetParamsGenerator())
+            logger.Log(CLASS "  - paramsBudget: " + Tools::ToString(this->paramsBudget));
+        if (this->optimizationMode && this->paramsGenerator == "halving")
+        {
+            logger.Log(CLASS "  - halvingRate: " + Tools::ToString(this->halvingRate));
+            logger.Log(CLASS "  - halvingMinHistory: " + Tools::ToString(this->halvingMinHistory, 2) + "%");
+        }
+        if (this->optimizationMode && this->paramsGenerator == "surrogate")
+        {
+            logger.Log(CLASS "  - surrogateInitial: " + Tools::ToString(this->surrogateInitial));
+            logger.Log(CLASS "  - surrogateParallel: " + Tools::ToString(this->surrogateParallel));
+        }
+        if (this->optimizationMode && this->paramsGenerator == "local")
+            logger.Log(CLASS "  - localInitial: " + Tools::ToString(this->localInitial));
+        if (this->optimizationMode && this->IsRandomParamsGenerator())
+            logger.Log(CLASS "  - paramsSeed: " + (this->paramsSeed ? Tools::ToString(this->paramsSeed) : std::string("random")));
+        if (!this->checkpointFile.empty())
+        {
+            logger.Log(CLASS "  - checkpointFile: \"" + this->checkpointFile + "\"");
+            logger.Log(CLASS "  - checkpointInterval: " + Tools::ToString(this->checkpointInterval));
+            logger.Log(CLASS "  - resume: " + std::string(this->resume ? "yes" : "no"));
+        }
+        if (!this->resultsFile.empty())
+            logger.Log(CLASS "  - resultsFile: \"" + this->resultsFile + "\"");
+        if (!this->heatmaps.empty())
+        {
+            logger.Log(CLASS "  - heatmaps: \"" + this->heatmaps + "\"");
+            logger.Log(CLASS "  - heatmapPrefix: \"" + this->heatmapPrefix + "\"");
+        }
+        if (!this->resultCacheFile.empty())
+            logger.Log(CLASS "  - resultCacheFile: \"" + this->resultCacheFile + "\"");
+        if (this->distributedMode != "none")
+        {
+            logger.Log(CLASS "  - distributedMode: \"" + this->distributedMode + "\"");
+            logger.Log(CLASS "  - distributedEndpoint: \"" + this->distributedEndpoint + "\"");
+            logger.Log(CLASS "  - distributedBatchSize: " + Tools::ToString(this->distributedBatchSize));
+        }
+        if (this->monteCarloRuns)
+        {
+            logger.Log(CLASS "  - monteCarloRuns: " + Tools::ToString(this->monteCarloRuns));
+            logger.Log(CLASS "  - monteCarloTopK: " + Tools::ToString(this->monteCarloTopK));
+            logger.Log(CLASS "  - monteCarloMethod: \"" + this->monteCarloMethod + "\"");
+            logger.Log(CLASS "  - monteCarloRuin: " + Tools::ToString(this->monteCarloRuin, 2) + "%");
+        }
+        if (this->walkForward)
+        {
+            logger.Log(CLASS "  - walkForwardInSample: " + Tools::ToString(this->walkForwardInSample) + " days");
+            logger.Log(CLASS "  - walkForwardOutOfSample: " + Tools::ToString(this->walkForwardOutOfSample) + " days");
+        }
+        if (this->pruneMinBalance)
+            logger.Log(CLASS "  - pruneMinBalance: " + Tools::ToString(this->pruneMinBalance, 2) + "%");
+        if (this->pruneMaxDrawdown)
+            logger.Log(CLASS "  - pruneMaxDrawdown: " + Tools::ToString(this->pruneMaxDrawdown, 2) + "%");
+        if (this->pruneTopK)
+        {
+            logger.Log(CLASS "  - pruneTopK: " + Tools::ToString(this->pruneTopK));
+            logger.Log(CLASS "  - pruneMaxLots: " + Tools::ToString(this->pruneMaxLots, 2));
+        }
     }
 }
@@ -31,6 +31,7 @@
 #define __BACKTESTER_CONF__
 
 #include <string>
+#include <boost/cstdint.hpp>
 
 namespace Conf
 {
@@ -45,8 +46,25 @@ namespace Backtester
     {
         public:
             explicit Conf(::Conf::Conf& from, Logger const& logger);
+
+            /*
+               Hash of the fields that change the trades of a strategy for given parameters and history.
+            */
+            boost::uint64_t GetTradesHash() const;
+
+            /*
+               True if the parameters generator depends on paramsSeed.
+            */
+            bool IsRandomParamsGenerator() const;
+
+            /*
+               True if the parameters generator tests paramsBudget points.
+            */
+            bool IsBudgetParamsGenerator() const;
+
             std::string strategy;
             std::string strategyParams;
+            std::string strategyPlugins;
             std::string pair;
             std::string baseCurrency;
             std::string counterCurrency;
@@ -59,13 +77,47 @@ namespace Backtester
             bool confirmLaunch;
             bool showTradeActions;
             bool showTradeDetails;
+            unsigned int progressInterval;
             float deposit;
             bool plotOutput;
             std::string plotDataFile;
             std::string plotSettingsFile;
             std::string paramsGenerator;
+            unsigned int geneticPopulation;
+            unsigned int geneticGenerations;
+            unsigned int geneticTournament;
+            float geneticCrossover;
+            float geneticMutation;
+            unsigned int paramsBudget;
+            unsigned int paramsSeed;
+            unsigned int halvingRate;
+            float halvingMinHistory;
+            unsigned int surrogateInitial;
+            unsigned int surrogateParallel;
+            unsigned int localInitial;
             std::string resultRanking;
+            std::string resultsFile;
+            std::string heatmaps;
+            std::string heatmapPrefix;
             bool fewerTicks;
+            std::string checkpointFile;
+            unsigned int checkpointInterval;
+            bool resume;
+            std::string resultCacheFile;
+            std::string distributedMode;
+            std::string distributedEndpoint;
+            unsigned int distributedBatchSize;
+            float pruneMinBalance;
+            float pruneMaxDrawdown;
+            unsigned int pruneTopK;
+            float pruneMaxLots;
+            unsigned int monteCarloRuns;
+            unsigned int monteCarloTopK;
+            std::string monteCarloMethod;
+            float monteCarloRuin;
+            bool walkForward;
+            unsigned int walkForwardInSample;
+            unsigned int walkForwardOutOfSample;
         private:
             void _Dump(Logger const& logger);
     };
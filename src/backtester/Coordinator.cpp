@@ -0,0 +1,350 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <boost/bind.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include "Coordinator.hpp"
+#include "Logger.hpp"
+#include "Conf.hpp"
+#include "Backtester.hpp"
+#include "StratParamsMap.hpp"
+#include "Report.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/Coordinator] "
+
+namespace Backtester
+{
+    class Coordinator::Connection :
+        public boost::enable_shared_from_this<Connection>,
+        private boost::noncopyable
+    {
+        public:
+            explicit Connection(Coordinator& coordinator, unsigned int id) :
+                _coordinator(coordinator), _socket(coordinator._ioService), _id(id), _greeted(false), _closed(false)
+            {
+            }
+
+            ~Connection()
+            {
+                std::map<unsigned int, StratParamsMap*>::iterator it = this->_pending.begin();
+                std::map<unsigned int, StratParamsMap*>::iterator itEnd = this->_pending.end();
+                for (; it != itEnd; ++it)
+                    delete it->second;
+            }
+
+            Network::Socket& GetSocket()
+            {
+                return this->_socket;
+            }
+
+            void AddPending(StratParamsMap* params)
+            {
+                this->_pending[params->GetId()] = params;
+            }
+
+            void Start()
+            {
+                this->_coordinator._logger.Log(CLASS "Worker " + Tools::ToString(this->_id) + " connected.");
+                this->_Read();
+            }
+
+        private:
+            void _Read()
+            {
+                boost::asio::async_read_until(this->_socket, this->_buffer, '\n',
+                        boost::bind(&Connection::_HandleRead, this->shared_from_this(), boost::asio::placeholders::error));
+            }
+
+            void _HandleRead(boost::system::error_code const& error)
+            {
+                if (error)
+                {
+                    this->_Close();
+                    return;
+                }
+                std::istream in(&this->_buffer);
+                std::string line;
+                std::getline(in, line);
+                std::istringstream message(line);
+                std::string type;
+                message >> type;
+                if (type == "hello")
+                    this->_HandleHello(message);
+                else if (!this->_greeted)
+                    this->_Write("error hello expected\n", true);
+                else if (type == "batch")
+                    this->_Write(this->_coordinator._GetBatch(*this));
+                else if (type == "report")
+                {
+                    if (this->_HandleReport(message))
+                        this->_Read();
+                    else
+                        this->_Close();
+                }
+                else
+                {
+                    this->_coordinator._logger.Log(CLASS "Unknown message \"" + type + "\" from worker " + Tools::ToString(this->_id) + ".", ::Logger::Warning);
+                    this->_Close();
+                }
+            }
+
+            void _HandleHello(std::istream& message)
+            {
+                unsigned int version = 0;
+                boost::uint64_t setupKey = 0;
+                message >> version >> std::hex >> setupKey;
+                if (version != Network::ProtocolVersion)
+                {
+                    this->_coordinator._logger.Log(CLASS "Worker " + Tools::ToString(this->_id) + " uses protocol version " + Tools::ToString(version) +
+                            " (expected " + Tools::ToString(static_cast<unsigned int>(Network::ProtocolVersion)) + ").", ::Logger::Warning);
+                    this->_Write("error protocol version mismatch\n", true);
+                }
+                else if (setupKey != this->_coordinator._setupKey)
+                {
+                    this->_coordinator._logger.Log(CLASS "Worker " + Tools::ToString(this->_id) + " has a different strategy, history or setup.", ::Logger::Warning);
+                    this->_Write("error strategy, history or setup mismatch\n", true);
+                }
+                else
+                {
+                    this->_greeted = true;
+                    this->_Write("hello\n");
+                }
+            }
+
+            bool _HandleReport(std::istream& message)
+            {
+                unsigned int id;
+                if (!(message >> id))
+                {
+                    this->_coordinator._logger.Log(CLASS "Invalid report from worker " + Tools::ToString(this->_id) + ".", ::Logger::Warning);
+                    return false;
+                }
+                std::map<unsigned int, StratParamsMap*>::iterator it = this->_pending.find(id);
+                if (it == this->_pending.end())
+                {
+                    this->_coordinator._logger.Log(CLASS "Unexpected report for parameters " + Tools::ToString(id) + " from worker " + Tools::ToString(this->_id) + ".", ::Logger::Warning);
+                    return false;
+                }
+                Report report(this->_coordinator._logger);
+                report.CopyParamsFrom(*it->second);
+                if (!report.Unserialize(message))
+                {
+                    this->_coordinator._logger.Log(CLASS "Invalid report for parameters " + Tools::ToString(id) + " from worker " + Tools::ToString(this->_id) + ".", ::Logger::Warning);
+                    return false;
+                }
+                delete it->second;
+                this->_pending.erase(it);
+                this->_coordinator._backtester.SubmitReportFromThread(report);
+                this->_coordinator._TaskFinished();
+                return true;
+            }
+
+            void _Write(std::string const& message, bool close = false)
+            {
+                this->_answer = message;
+                boost::asio::async_write(this->_socket, boost::asio::buffer(this->_answer),
+                        boost::bind(&Connection::_HandleWrite, this->shared_from_this(), boost::asio::placeholders::error, close));
+            }
+
+            void _HandleWrite(boost::system::error_code const& error, bool close)
+            {
+                if (error || close)
+                    this->_Close();
+                else
+                    this->_Read();
+            }
+
+            void _Close()
+            {
+                if (this->_closed)
+                    return;
+                this->_closed = true;
+                boost::system::error_code ignored;
+                this->_socket.close(ignored);
+                unsigned int nbRequeued = this->_pending.size();
+                std::map<unsigned int, StratParamsMap*>::iterator it = this->_pending.begin();
+                std::map<unsigned int, StratParamsMap*>::iterator itEnd = this->_pending.end();
+                for (; it != itEnd; ++it)
+                    this->_coordinator._Requeue(it->second);
+                this->_pending.clear();
+                if (nbRequeued)
+                    this->_coordinator._logger.Log(CLASS "Worker " + Tools::ToString(this->_id) + " disconnected, " + Tools::ToString(nbRequeued) +
+                            " unfinished parameter" + (nbRequeued > 1 ? "s" : "") + " requeued.", ::Logger::Warning);
+                else
+                    this->_coordinator._logger.Log(CLASS "Worker " + Tools::ToString(this->_id) + " disconnected.");
+            }
+
+            Coordinator& _coordinator;
+            Network::Socket _socket;
+            boost::asio::streambuf _buffer;
+            std::string _answer;
+            std::map<unsigned int, StratParamsMap*> _pending;
+            unsigned int _id;
+            bool _greeted;
+            bool _closed;
+    };
+
+    Coordinator::Coordinator(Logger const& logger, Conf const& conf, Backtester& backtester, boost::uint64_t setupKey) :
+        _logger(logger), _conf(conf), _backtester(backtester), _setupKey(setupKey), _acceptor(_ioService),
+        _generatorFinished(false), _nbPendingTasks(0), _nbConnections(0)
+    {
+    }
+
+    Coordinator::~Coordinator()
+    {
+        std::list<StratParamsMap*>::iterator it = this->_requeued.begin();
+        std::list<StratParamsMap*>::iterator itEnd = this->_requeued.end();
+        for (; it != itEnd; ++it)
+            delete *it;
+    }
+
+    bool Coordinator::Run()
+    {
+        Network::Endpoint endpoint;
+        if (!Network::ParseEndpoint(this->_conf.distributedEndpoint, endpoint))
+        {
+            this->_logger.Log(CLASS "Invalid endpoint \"" + this->_conf.distributedEndpoint + "\".", ::Logger::Error);
+            return false;
+        }
+        if (this->_conf.distributedEndpoint.compare(0, 5, "unix:") == 0)
+            std::remove(this->_conf.distributedEndpoint.substr(5).c_str()); // stale socket of a previous run
+        try
+        {
+            this->_acceptor.open(endpoint.protocol());
+            this->_acceptor.set_option(boost::asio::socket_base::reuse_address(true));
+            this->_acceptor.bind(endpoint);
+            this->_acceptor.listen();
+        }
+        catch (std::exception& e)
+        {
+            this->_logger.Log(CLASS "Failed to listen on \"" + this->_conf.distributedEndpoint + "\": " + e.what() + ".", ::Logger::Error);
+            return false;
+        }
+        this->_logger.Log(CLASS "Waiting for workers on \"" + this->_conf.distributedEndpoint + "\".");
+        this->_Accept();
+        // returns when the acceptor is closed and every worker is gone
+        this->_ioService.run();
+        return this->_IsFinished();
+    }
+
+    void Coordinator::_Accept()
+    {
+        boost::shared_ptr<Connection> connection(new Connection(*this, ++this->_nbConnections));
+        this->_acceptor.async_accept(connection->GetSocket(),
+                boost::bind(&Coordinator::_HandleAccept, this, connection, boost::asio::placeholders::error));
+    }
+
+    void Coordinator::_HandleAccept(boost::shared_ptr<Connection> connection, boost::system::error_code const& error)
+    {
+        if (error)
+        {
+            if (error != boost::asio::error::operation_aborted)
+                this->_logger.Log(CLASS "Failed to accept a worker: " + error.message() + ".", ::Logger::Warning);
+            return;
+        }
+        connection->Start();
+        this->_Accept();
+    }
+
+    std::string Coordinator::_GetBatch(Connection& connection)
+    {
+        std::ostringstream batch;
+        unsigned int size = 0;
+        while (size < this->_conf.distributedBatchSize)
+        {
+            StratParamsMap* params;
+            if (!this->_requeued.empty())
+            {
+                params = this->_requeued.front();
+                this->_requeued.pop_front();
+            }
+            else if (!this->_generatorFinished)
+            {
+                params = new StratParamsMap(this->_logger);
+                Backtester::ParamsStatus status = this->_backtester.GetNewParams(*params, false); // never block the connections
+                if (status != Backtester::ParamsReady)
+                {
+                    delete params;
+                    if (status == Backtester::ParamsFinished)
+                        this->_generatorFinished = true;
+                    break;
+                }
+            }
+            else
+                break;
+            params->Serialize(batch);
+            batch << "\n";
+            connection.AddPending(params);
+            ++this->_nbPendingTasks;
+            ++size;
+        }
+        if (size)
+        {
+            // the workers prune on the results of all of them
+            std::ostringstream header;
+            header << "params " << size;
+            float threshold = this->_backtester.GetScoreThreshold();
+            if (threshold > -std::numeric_limits<float>::infinity())
+            {
+                header.precision(9); // enough to read back the same float
+                header << " " << threshold;
+            }
+            return header.str() + "\n" + batch.str();
+        }
+        if (this->_IsFinished())
+        {
+            boost::system::error_code ignored;
+            this->_acceptor.close(ignored);
+            return "end\n";
+        }
+        // the last parameters (or the ones needed to generate more) are still being tested by other workers
+        return "wait\n";
+    }
+
+    void Coordinator::_Requeue(StratParamsMap* params)
+    {
+        this->_requeued.push_back(params);
+        --this->_nbPendingTasks;
+    }
+
+    void Coordinator::_TaskFinished()
+    {
+        --this->_nbPendingTasks;
+    }
+
+    bool Coordinator::_IsFinished() const
+    {
+        return this->_generatorFinished && this->_requeued.empty() && !this->_nbPendingTasks;
+    }
+}
@@ -0,0 +1,80 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_COORDINATOR__
+#define __BACKTESTER_COORDINATOR__
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
+#include <list>
+#include <string>
+#include "Network.hpp"
+
+namespace Backtester
+{
+    class Logger;
+    class Conf;
+    class Backtester;
+    class StratParamsMap;
+
+    /*
+       Hands out batches of parameters to the workers and submits their reports to the backtester.
+       The parameters of a worker that disconnects are given to the next worker asking for a batch.
+       Everything runs in the thread calling Run().
+    */
+    class Coordinator :
+        private boost::noncopyable
+    {
+        public:
+            explicit Coordinator(Logger const& logger, Conf const& conf, Backtester& backtester, boost::uint64_t setupKey);
+            ~Coordinator();
+            bool Run();
+        private:
+            class Connection;
+            void _Accept();
+            void _HandleAccept(boost::shared_ptr<Connection> connection, boost::system::error_code const& error);
+            std::string _GetBatch(Connection& connection);
+            void _Requeue(StratParamsMap* params);
+            void _TaskFinished();
+            bool _IsFinished() const;
+            Logger const& _logger;
+            Conf const& _conf;
+            Backtester& _backtester;
+            boost::uint64_t _setupKey;
+            boost::asio::io_service _ioService;
+            Network::Acceptor _acceptor;
+            std::list<StratParamsMap*> _requeued;
+            bool _generatorFinished;
+            unsigned int _nbPendingTasks;
+            unsigned int _nbConnections;
+    };
+}
+
+#endif
@@ -31,8 +31,8 @@
 
 namespace Backtester
 {
-    bool Feedback::IsNeeded() const
+    Feedback::Feedback() :
+        Core::Feedback(false)
     {
-        return false;
     }
 }
@@ -38,7 +38,7 @@ namespace Backtester
         public Core::Feedback
     {
         public:
-            virtual bool IsNeeded() const;
+            explicit Feedback();
     };
 }
 
@@ -0,0 +1,174 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cmath>
+#include <limits>
+#include "GaussianProcess.hpp"
+
+namespace
+{
+    double const NoiseVariance = 1e-4;
+    double const LengthScales[] = { 0.05, 0.1, 0.2, 0.4, 0.8 };
+}
+
+namespace Backtester
+{
+    GaussianProcess::GaussianProcess() :
+        _outputMean(0), _outputDeviation(1), _lengthScale(LengthScales[0])
+    {
+    }
+
+    bool GaussianProcess::Fit(std::vector<Input> const& inputs, std::vector<double> const& outputs)
+    {
+        if (inputs.empty() || inputs.size() != outputs.size())
+            return false;
+        this->_inputs = inputs;
+        double sum = 0;
+        std::vector<double>::const_iterator it = outputs.begin();
+        std::vector<double>::const_iterator itEnd = outputs.end();
+        for (; it != itEnd; ++it)
+            sum += *it;
+        this->_outputMean = sum / outputs.size();
+        double variance = 0;
+        for (it = outputs.begin(); it != itEnd; ++it)
+            variance += (*it - this->_outputMean) * (*it - this->_outputMean);
+        this->_outputDeviation = std::sqrt(variance / outputs.size());
+        if (this->_outputDeviation <= 0)
+            this->_outputDeviation = 1;
+        this->_outputs.clear();
+        for (it = outputs.begin(); it != itEnd; ++it)
+            this->_outputs.push_back((*it - this->_outputMean) / this->_outputDeviation);
+
+        // length scale relative to the diagonal of the unit hypercube
+        double scale = std::sqrt(static_cast<double>(inputs.front().size() > 0 ? inputs.front().size() : 1));
+        double bestLengthScale = 0;
+        double bestLikelihood = -std::numeric_limits<double>::infinity();
+        for (unsigned int i = 0; i < sizeof(LengthScales) / sizeof(*LengthScales); ++i)
+            if (this->_Factorize(LengthScales[i] * scale))
+            {
+                double likelihood = this->_LogLikelihood();
+                if (likelihood > bestLikelihood)
+                {
+                    bestLikelihood = likelihood;
+                    bestLengthScale = LengthScales[i] * scale;
+                }
+            }
+        if (bestLengthScale <= 0)
+            return false;
+        return this->_Factorize(bestLengthScale);
+    }
+
+    void GaussianProcess::Predict(Input const& input, double& mean, double& deviation) const
+    {
+        unsigned int n = this->_inputs.size();
+        std::vector<double> k(n);
+        double m = 0;
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            k[i] = this->_Kernel(input, this->_inputs[i], this->_lengthScale);
+            m += k[i] * this->_alpha[i];
+        }
+        // v = L^-1 * k
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            for (unsigned int j = 0; j < i; ++j)
+                k[i] -= this->_cholesky[i][j] * k[j];
+            k[i] /= this->_cholesky[i][i];
+        }
+        double variance = 1;
+        for (unsigned int i = 0; i < n; ++i)
+            variance -= k[i] * k[i];
+        mean = m * this->_outputDeviation + this->_outputMean;
+        deviation = std::sqrt(variance > 0 ? variance : 0) * this->_outputDeviation;
+    }
+
+    double GaussianProcess::ExpectedImprovement(double mean, double deviation, double best)
+    {
+        if (deviation <= 0)
+            return mean > best ? mean - best : 0;
+        double z = (mean - best) / deviation;
+        double cdf = 0.5 * std::erfc(-z / std::sqrt(2.0));
+        double pdf = std::exp(-0.5 * z * z) / std::sqrt(2 * M_PI);
+        return (mean - best) * cdf + deviation * pdf;
+    }
+
+    double GaussianProcess::_Kernel(Input const& a, Input const& b, double lengthScale) const
+    {
+        double distance = 0;
+        for (unsigned int i = 0; i < a.size(); ++i)
+            distance += (a[i] - b[i]) * (a[i] - b[i]);
+        return std::exp(-distance / (2 * lengthScale * lengthScale));
+    }
+
+    bool GaussianProcess::_Factorize(double lengthScale)
+    {
+        unsigned int n = this->_inputs.size();
+        this->_lengthScale = lengthScale;
+        this->_cholesky.assign(n, std::vector<double>(n, 0));
+        for (unsigned int i = 0; i < n; ++i)
+            for (unsigned int j = 0; j <= i; ++j)
+            {
+                double sum = this->_Kernel(this->_inputs[i], this->_inputs[j], lengthScale) + (i == j ? NoiseVariance : 0);
+                for (unsigned int k = 0; k < j; ++k)
+                    sum -= this->_cholesky[i][k] * this->_cholesky[j][k];
+                if (i == j)
+                {
+                    if (sum <= 0)
+                        return false;
+                    this->_cholesky[i][i] = std::sqrt(sum);
+                }
+                else
+                    this->_cholesky[i][j] = sum / this->_cholesky[j][j];
+            }
+        // alpha = L^-T * L^-1 * outputs
+        this->_alpha = this->_outputs;
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            for (unsigned int j = 0; j < i; ++j)
+                this->_alpha[i] -= this->_cholesky[i][j] * this->_alpha[j];
+            this->_alpha[i] /= this->_cholesky[i][i];
+        }
+        for (unsigned int i = n; i > 0; --i)
+        {
+            for (unsigned int j = i; j < n; ++j)
+                this->_alpha[i - 1] -= this->_cholesky[j][i - 1] * this->_alpha[j];
+            this->_alpha[i - 1] /= this->_cholesky[i - 1][i - 1];
+        }
+        return true;
+    }
+
+    double GaussianProcess::_LogLikelihood() const
+    {
+        // constant term omitted
+        double likelihood = 0;
+        for (unsigned int i = 0; i < this->_outputs.size(); ++i)
+            likelihood -= 0.5 * this->_outputs[i] * this->_alpha[i] + std::log(this->_cholesky[i][i]);
+        return likelihood;
+    }
+}
@@ -0,0 +1,76 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_GAUSSIANPROCESS__
+#define __BACKTESTER_GAUSSIANPROCESS__
+
+#include <vector>
+
+namespace Backtester
+{
+    /*
+       Gaussian process regression with a squared exponential kernel, for inputs in [0, 1]^n.
+       The observations are normalized, and the length scale maximizing the marginal likelihood
+       is picked among a few candidates by Fit().
+    */
+    class GaussianProcess
+    {
+        public:
+            typedef std::vector<double> Input;
+            GaussianProcess();
+
+            /*
+               Returns false if there are no observations or if the kernel matrix is singular.
+            */
+            bool Fit(std::vector<Input> const& inputs, std::vector<double> const& outputs);
+
+            /*
+               Mean and standard deviation of the output at input (in the unit of the outputs).
+            */
+            void Predict(Input const& input, double& mean, double& deviation) const;
+
+            /*
+               Expected improvement over best of an output to maximize.
+            */
+            static double ExpectedImprovement(double mean, double deviation, double best);
+        private:
+            double _Kernel(Input const& a, Input const& b, double lengthScale) const;
+            bool _Factorize(double lengthScale);
+            double _LogLikelihood() const;
+            std::vector<Input> _inputs;
+            std::vector<double> _outputs; // normalized
+            double _outputMean;
+            double _outputDeviation;
+            double _lengthScale;
+            std::vector<std::vector<double> > _cholesky; // lower triangle of the kernel matrix
+            std::vector<double> _alpha; // kernel matrix^-1 * outputs
+    };
+}
+
+#endif
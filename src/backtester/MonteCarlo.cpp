@@ -0,0 +1,142 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <ctime>
+#include <random>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include "MonteCarlo.hpp"
+#include "Report.hpp"
+#include "Logger.hpp"
+#include "Conf.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/MonteCarlo] "
+
+namespace Backtester
+{
+    MonteCarlo::MonteCarlo(Logger const& logger, Conf const& conf) :
+        _logger(logger), _conf(conf), _seed(conf.paramsSeed ? conf.paramsSeed : static_cast<unsigned int>(std::time(0)))
+    {
+    }
+
+    void MonteCarlo::Run(Report const& report)
+    {
+        this->_profits.clear();
+        std::list<Report::Trade>::const_iterator it = report.GetTrades().begin();
+        std::list<Report::Trade>::const_iterator itEnd = report.GetTrades().end();
+        for (; it != itEnd; ++it)
+            this->_profits.push_back(it->counterCurrencyProfit);
+        if (this->_profits.empty())
+        {
+            this->_logger.Log(CLASS "No trades for " + report.GetParams().GetFloatParamsString() + ", skipping.");
+            return;
+        }
+        unsigned int nbRuns = this->_conf.monteCarloRuns;
+        this->_finalBalances.resize(nbRuns);
+        this->_maxDrawdowns.resize(nbRuns);
+        this->_ruined.resize(nbRuns);
+        unsigned int nbThreads = boost::thread::hardware_concurrency();
+        if (nbThreads < 1)
+            nbThreads = 1;
+        if (nbThreads > nbRuns)
+            nbThreads = nbRuns;
+        boost::thread_group threads;
+        for (unsigned int i = 0; i < nbThreads; ++i)
+            threads.create_thread(boost::bind(&MonteCarlo::_Simulate, this, this->_seed + i, nbRuns * i / nbThreads, nbRuns * (i + 1) / nbThreads));
+        threads.join_all();
+        // next report, other draws
+        this->_seed += nbThreads;
+
+        unsigned int nbRuined = std::count(this->_ruined.begin(), this->_ruined.end(), 1);
+        unsigned int nbLosses = 0;
+        std::vector<float>::const_iterator balance = this->_finalBalances.begin();
+        std::vector<float>::const_iterator balanceEnd = this->_finalBalances.end();
+        for (; balance != balanceEnd; ++balance)
+            if (*balance < this->_conf.deposit)
+                ++nbLosses;
+        this->_logger.Log(CLASS "=== Monte Carlo: " + Tools::ToString(nbRuns) + " " + this->_conf.monteCarloMethod + " runs of " + Tools::ToString(this->_profits.size()) +
+                " trades for " + report.GetParams().GetFloatParamsString() + " ===");
+        this->_logger.Log(CLASS " - Final balance:\t5%\t25%\t50%\t75%\t95%");
+        this->_logger.Log(CLASS "   " + this->_conf.counterCurrency + "\t\t" +
+                Tools::ToString(this->_GetPercentile(this->_finalBalances, 5), 2) + "\t" +
+                Tools::ToString(this->_GetPercentile(this->_finalBalances, 25), 2) + "\t" +
+                Tools::ToString(this->_GetPercentile(this->_finalBalances, 50), 2) + "\t" +
+                Tools::ToString(this->_GetPercentile(this->_finalBalances, 75), 2) + "\t" +
+                Tools::ToString(this->_GetPercentile(this->_finalBalances, 95), 2));
+        this->_logger.Log(CLASS " - Max drawdown:\t50%\t75%\t95%\t99%");
+        this->_logger.Log(CLASS "   %\t\t" +
+                Tools::ToString(this->_GetPercentile(this->_maxDrawdowns, 50), 2) + "\t" +
+                Tools::ToString(this->_GetPercentile(this->_maxDrawdowns, 75), 2) + "\t" +
+                Tools::ToString(this->_GetPercentile(this->_maxDrawdowns, 95), 2) + "\t" +
+                Tools::ToString(this->_GetPercentile(this->_maxDrawdowns, 99), 2));
+        this->_logger.Log(CLASS " - Probability of loss: " + Tools::ToString(nbLosses * 100.0 / nbRuns, 2) + "%.");
+        this->_logger.Log(CLASS " - Risk of ruin (losing " + Tools::ToString(this->_conf.monteCarloRuin, 2) + "% of the deposit): " + Tools::ToString(nbRuined * 100.0 / nbRuns, 2) + "%.",
+                nbRuined ? ::Logger::Warning : ::Logger::Info);
+    }
+
+    void MonteCarlo::_Simulate(unsigned int seed, unsigned int begin, unsigned int end)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<unsigned int> pick(0, this->_profits.size() - 1);
+        std::vector<float> profits(this->_profits);
+        bool resample = this->_conf.monteCarloMethod == "resample";
+        float ruin = this->_conf.deposit * (1 - this->_conf.monteCarloRuin / 100);
+        for (unsigned int run = begin; run < end; ++run)
+        {
+            if (!resample)
+                std::shuffle(profits.begin(), profits.end(), rng);
+            float balance = this->_conf.deposit;
+            float peak = balance;
+            float maxDrawdown = 0;
+            bool ruined = false;
+            for (unsigned int i = 0; i < profits.size(); ++i)
+            {
+                balance += resample ? this->_profits[pick(rng)] : profits[i];
+                if (balance > peak)
+                    peak = balance;
+                else if (peak > 0 && (peak - balance) / peak > maxDrawdown)
+                    maxDrawdown = (peak - balance) / peak;
+                if (balance <= ruin)
+                    ruined = true;
+            }
+            this->_finalBalances[run] = balance;
+            this->_maxDrawdowns[run] = maxDrawdown * 100;
+            this->_ruined[run] = ruined;
+        }
+    }
+
+    float MonteCarlo::_GetPercentile(std::vector<float>& values, float percentile) const
+    {
+        unsigned int n = static_cast<unsigned int>(percentile / 100 * (values.size() - 1) + 0.5);
+        std::nth_element(values.begin(), values.begin() + n, values.end());
+        return values[n];
+    }
+}
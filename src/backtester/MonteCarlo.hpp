@@ -0,0 +1,69 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_MONTECARLO__
+#define __BACKTESTER_MONTECARLO__
+
+#include <boost/noncopyable.hpp>
+#include <vector>
+
+namespace Backtester
+{
+    class Logger;
+    class Conf;
+    class Report;
+
+    /*
+       Robustness of a report: the sequence of its trades is resampled (drawn with replacement)
+       or shuffled monteCarloRuns times, and the distributions of the final balance and of the
+       maximal drawdown are logged with the risk of ruin (losing monteCarloRuin percent of the
+       deposit at some point).
+       The runs are split between the cores, each with its own random generator and its own
+       part of the results.
+    */
+    class MonteCarlo :
+        private boost::noncopyable
+    {
+        public:
+            explicit MonteCarlo(Logger const& logger, Conf const& conf);
+            void Run(Report const& report);
+        private:
+            void _Simulate(unsigned int seed, unsigned int begin, unsigned int end);
+            float _GetPercentile(std::vector<float>& values, float percentile) const;
+            Logger const& _logger;
+            Conf const& _conf;
+            unsigned int _seed;
+            std::vector<float> _profits; // of the trades, read only while simulating
+            std::vector<float> _finalBalances; // by run
+            std::vector<float> _maxDrawdowns; // by run, in percent
+            std::vector<unsigned char> _ruined; // by run
+    };
+}
+
+#endif
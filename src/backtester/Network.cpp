@@ -0,0 +1,62 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <boost/lexical_cast.hpp>
+#include "Network.hpp"
+
+namespace Backtester
+{
+    namespace Network
+    {
+        bool ParseEndpoint(std::string const& str, Endpoint& endpoint)
+        {
+            if (str.compare(0, 5, "unix:") == 0)
+            {
+                if (str.size() == 5)
+                    return false;
+                endpoint = boost::asio::local::stream_protocol::endpoint(str.substr(5));
+                return true;
+            }
+            size_t colon = str.rfind(':');
+            if (colon == std::string::npos)
+                return false;
+            try
+            {
+                boost::asio::ip::address address = boost::asio::ip::address::from_string(str.substr(0, colon));
+                unsigned short port = boost::lexical_cast<unsigned short>(str.substr(colon + 1));
+                endpoint = boost::asio::ip::tcp::endpoint(address, port);
+            }
+            catch (std::exception&)
+            {
+                return false;
+            }
+            return true;
+        }
+    }
+}
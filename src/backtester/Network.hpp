@@ -0,0 +1,65 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_NETWORK__
+#define __BACKTESTER_NETWORK__
+
+#include <string>
+#include <boost/asio.hpp>
+
+namespace Backtester
+{
+    /*
+       Shared by the coordinator and the workers of a distributed optimization.
+
+       Text protocol, one message per line:
+         worker -> coordinator:
+           hello <version> <setup key>          (once, answered by "hello" or "error <reason>")
+           batch                                (answered by "params <n> [<score threshold>]" followed by n parameter lines, "wait" or "end")
+           report <params id> <serialized report>
+    */
+    namespace Network
+    {
+        typedef boost::asio::generic::stream_protocol::socket Socket;
+        typedef boost::asio::generic::stream_protocol::endpoint Endpoint;
+        typedef boost::asio::basic_socket_acceptor<boost::asio::generic::stream_protocol> Acceptor;
+
+        enum
+        {
+            ProtocolVersion = 1,
+        };
+
+        /*
+           "unix:/path/to/socket" or "<ip address>:<port>".
+        */
+        bool ParseEndpoint(std::string const& str, Endpoint& endpoint);
+    }
+}
+
+#endif
@@ -54,15 +54,61 @@ namespace Backtester
         return true;
     }
 
+    bool ParamsGenerator::GenerateParams(unsigned int, StratParamsMap&) const
+    {
+        return false;
+    }
+
     void ParamsGenerator::ReportFeedback(Report const&)
     {
     }
 
+    bool ParamsGenerator::IsWaitingForReports() const
+    {
+        return false;
+    }
+
     unsigned int ParamsGenerator::GetNbTotalTasks() const
     {
         return 0;
     }
 
+    bool ParamsGenerator::_HasConstraints() const
+    {
+        return !this->_constraints.empty();
+    }
+
+    void ParamsGenerator::_SetConstraintValue(std::string const& name, float value)
+    {
+        lua_pushnumber(this->_lua.Context(), value);
+        lua_setglobal(this->_lua.Context(), name.c_str());
+    }
+
+    bool ParamsGenerator::_CheckConstraints()
+    {
+        lua_State* state = this->_lua.Context();
+        std::vector<Constraint>::iterator it = this->_constraints.begin();
+        std::vector<Constraint>::iterator itEnd = this->_constraints.end();
+        for (; it != itEnd; ++it)
+        {
+            it->function.push(state);
+            if (lua_pcall(state, 0, 1, 0))
+            {
+                // an invalid expression rejects everything
+                if (!it->failed)
+                    this->_logger.Log(CLASS "Failed to evaluate constraint \"" + it->expression + "\": \"" + lua_tostring(state, -1) + "\".", ::Logger::Error);
+                it->failed = true;
+                lua_pop(state, 1);
+                return false;
+            }
+            bool holds = lua_toboolean(state, -1);
+            lua_pop(state, 1);
+            if (!holds)
+                return false;
+        }
+        return true;
+    }
+
     bool ParamsGenerator::ProcessFile(std::string const& file)
     {
         // load file
@@ -130,6 +176,33 @@ namespace Backtester
                     }
                 }
             }
+            // constraint table
+            if (luabind::type(luabind::globals(this->_lua.Context())["constraint"]) == LUA_TTABLE)
+            {
+                luabind::iterator it(luabind::globals(this->_lua.Context())["constraint"]);
+                luabind::iterator itEnd;
+                for (; it != itEnd; ++it)
+                {
+                    if (luabind::type(*it) != LUA_TSTRING)
+                    {
+                        this->_logger.Log(CLASS "Invalid constraint, expecting a string.", ::Logger::Warning);
+                        continue;
+                    }
+                    Constraint c;
+                    c.expression = luabind::object_cast<std::string>(*it);
+                    c.failed = false;
+                    if (luaL_loadstring(this->_lua.Context(), ("return " + c.expression).c_str()))
+                    {
+                        this->_logger.Log(CLASS "Invalid constraint \"" + c.expression + "\": \"" + lua_tostring(this->_lua.Context(), -1) + "\".", ::Logger::Error);
+                        lua_pop(this->_lua.Context(), 1);
+                        return false;
+                    }
+                    c.function = luabind::object(luabind::from_stack(this->_lua.Context(), -1));
+                    lua_pop(this->_lua.Context(), 1);
+                    this->_constraints.push_back(c);
+                    this->_logger.Log(CLASS "Constraint \"" + c.expression + "\".");
+                }
+            }
             return true;
         }
         catch (std::exception& e)
@@ -31,7 +31,14 @@
 #define __BACKTESTER_PARAMSGENERATOR__
 
 #include <boost/noncopyable.hpp>
+#include <vector>
 #include "lua/LuaContext.hpp"
+#include "tools/Registry.hpp"
+
+namespace Core
+{
+    class History;
+}
 
 namespace Backtester
 {
@@ -49,18 +56,59 @@ namespace Backtester
             bool ProcessFile(std::string const& file);
             virtual bool Initialize();
             virtual bool GenerateNextParams(StratParamsMap& params) = 0;
+
+            /*
+               Random access: writes the parameters of task id (1 to GetNbTotalTasks()), the same
+               ones GenerateNextParams() gives for this id. Returns false if id is out of range or
+               if the generator does not support it (default).
+            */
+            virtual bool GenerateParams(unsigned int id, StratParamsMap& params) const;
+
+            /*
+               Called with every finished report, its score set by the result ranking (meaningless
+               if the report failed or was pruned).
+            */
             virtual void ReportFeedback(Report const& report);
+
+            /*
+               True if GenerateNextParams() returned false only until more reports are given to
+               ReportFeedback(), not because the generation is over.
+            */
+            virtual bool IsWaitingForReports() const;
             virtual unsigned int GetNbTotalTasks() const;
             std::string const& GetName() const;
         protected:
+
+            /*
+               Constraints are Lua expressions of the float parameters in the constraint table of the
+               parameters file (e.g. "macFastMa < macSlowMa"). Set every float parameter with
+               _SetConstraintValue(), then _CheckConstraints() is true if all of them hold.
+            */
+            bool _HasConstraints() const;
+            void _SetConstraintValue(std::string const& name, float value);
+            bool _CheckConstraints();
             Logger const& _logger;
             Conf const& _conf;
         private:
+            struct Constraint
+            {
+                std::string expression;
+                luabind::object function;
+                bool failed; // error already logged
+            };
             virtual bool _AddFloatParam(std::string const& name, float start, float step, unsigned int iterations) = 0;
             virtual bool _AddStringParam(std::string const& name, std::string const& value) = 0;
             Lua::LuaContext _lua;
             std::string _name;
+            std::vector<Constraint> _constraints;
     };
+
+    typedef ParamsGenerator* (*ParamsGeneratorFactory)(Logger const& logger, Conf& conf, Core::History const& history);
+
+    /*
+       Parameters generators of the optimization mode, registered by name like the strategies (see Core::StrategyRegistry).
+    */
+    typedef Tools::Registry<ParamsGeneratorFactory> ParamsGeneratorRegistry;
 }
 
 #endif
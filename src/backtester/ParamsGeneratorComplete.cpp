@@ -27,49 +27,64 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <limits>
 #include "ParamsGeneratorComplete.hpp"
 #include "Logger.hpp"
-#include "tools/ToString.hpp"
 #include "StratParamsMap.hpp"
 #include "Conf.hpp"
+#include "tools/ToString.hpp"
 
 #define CLASS "[Backtester/ParamsGeneratorComplete] "
 
 namespace Backtester
 {
+    namespace
+    {
+        ParamsGenerator* Create(Logger const& logger, Conf& conf, Core::History const&)
+        {
+            return new ParamsGeneratorComplete(logger, conf);
+        }
+
+        ParamsGeneratorRegistry::Registrar registrar("complete", &Create);
+    }
+
     ParamsGeneratorComplete::ParamsGeneratorComplete(Logger const& logger, Conf& conf) :
-        ParamsGenerator("complete", logger, conf), _noMoreParams(false), _nextParamId(0), _nbTasks(0)
+        ParamsGeneratorGrid("complete", logger, conf), _nextParamId(0), _nbTasks(1)
     {
     }
 
     bool ParamsGeneratorComplete::Initialize()
     {
-        if (this->_floatParams.size())
+        if (!ParamsGeneratorGrid::Initialize())
+            return false;
+        if (this->_GetGridSize() > std::numeric_limits<unsigned int>::max())
         {
-            this->_nbTasks = 1;
-            std::string floatRes = Tools::ToString(this->_floatParams.size()) + " parameter" + (this->_floatParams.size() > 1 ? "s" : "") + ".";
-            std::vector<FloatParam>::const_iterator it = this->_floatParams.begin();
-            std::vector<FloatParam>::const_iterator itEnd = this->_floatParams.end();
-            for (; it != itEnd; ++it)
-            {
-                floatRes += " \"" + it->name + "\" (" + Tools::ToString(it->start, 2) + ", " + Tools::ToString(it->step, 2) + ", " + Tools::ToString(it->iterations) + ")";
-                this->_nbTasks *= it->iterations;
-            }
-            this->_logger.Log(CLASS + floatRes);
+            this->_logger.Log(CLASS "Too many parameter combinations.", ::Logger::Error);
+            return false;
         }
-        else
-            this->_logger.Log(CLASS "No parameters.");
-        if (this->_stringParams.size())
+        // no optimization: only the first values
+        if (!this->_conf.optimizationMode)
+            return true;
+        if (!this->_HasConstraints())
         {
-            std::string stringRes = Tools::ToString(this->_stringParams.size()) + " string" + (this->_stringParams.size() > 1 ? "s" : "") + ".";
-            std::vector<StringParam>::const_iterator it = this->_stringParams.begin();
-            std::vector<StringParam>::const_iterator itEnd = this->_stringParams.end();
-            for (; it != itEnd; ++it)
-                stringRes += " \"" + it->name + "\" (" + Tools::ToString(it->value.size()) + ")";
-            this->_logger.Log(CLASS + stringRes);
+            this->_nbTasks = this->_GetGridSize();
+            return true;
+        }
+        // constraints evaluated once per combination, before any dispatch
+        Point point;
+        for (boost::uint64_t i = 0; i < this->_GetGridSize(); ++i)
+        {
+            this->_IndexToPoint(i, point);
+            if (this->_IsValid(point))
+                this->_validIndexes.push_back(i);
+        }
+        this->_nbTasks = this->_validIndexes.size();
+        this->_logger.Log(CLASS + Tools::ToString(this->_nbTasks) + " parameter combinations out of " + Tools::ToString(this->_GetGridSize()) + " satisfy the constraints.");
+        if (!this->_nbTasks)
+        {
+            this->_logger.Log(CLASS "No parameter combination satisfies the constraints.", ::Logger::Error);
+            return false;
         }
-        else
-            this->_logger.Log(CLASS "No strings.");
         return true;
     }
 
@@ -78,84 +93,22 @@ namespace Backtester
         return this->_nbTasks;
     }
 
-    bool ParamsGeneratorComplete::_AddFloatParam(std::string const& name, float start, float step, unsigned int iterations)
-    {
-        FloatParam p;
-        p.name = name;
-        p.start = start;
-        p.step = step;
-        p.iterations = iterations;
-        p.current = p.start;
-        this->_floatParams.push_back(p);
-        return true;
-    }
-
-    bool ParamsGeneratorComplete::_AddStringParam(std::string const& name, std::string const& value)
-    {
-        StringParam p;
-        p.name = name;
-        p.value = value;
-        this->_stringParams.push_back(p);
-        return true;
-    }
-
     bool ParamsGeneratorComplete::GenerateNextParams(StratParamsMap& params)
     {
-        // check finished generation
-        if (this->_noMoreParams)
+        if (!this->GenerateParams(this->_nextParamId + 1, params))
             return false;
-
-        // check empty parameters (parsing failure / empty parameters file)
-        if (this->_floatParams.empty() || !this->_conf.optimizationMode)
-        {
-            this->_WriteParams(params); // write strings
-            this->_noMoreParams = true;
-            return true;
-        }
-
-        // return the current parameters
-        this->_WriteParams(params);
-
-        // generate the next parameters
-        unsigned int pos = this->_floatParams.size() - 1;
-        while (true)
-        {
-            FloatParam& p = this->_floatParams[pos];
-            p.current += p.step;
-            if (p.iterations <= 1 || p.current >= p.start + p.step * p.iterations)
-            {
-                if (!pos)
-                {
-                    this->_noMoreParams = true;
-                    break;
-                }
-                else
-                {
-                    p.current = p.start;
-                    --pos;
-                }
-            }
-            else
-                break;
-        }
+        ++this->_nextParamId;
         return true;
     }
 
-    void ParamsGeneratorComplete::_WriteParams(StratParamsMap& params)
+    bool ParamsGeneratorComplete::GenerateParams(unsigned int id, StratParamsMap& params) const
     {
-        ++this->_nextParamId;
-        params.SetId(this->_nextParamId);
-        {
-            std::vector<FloatParam>::const_iterator it = this->_floatParams.begin();
-            std::vector<FloatParam>::const_iterator itEnd = this->_floatParams.end();
-            for (; it != itEnd; ++it)
-                params.SetFloat(it->name, it->current);
-        }
-        {
-            std::vector<StringParam>::const_iterator it = this->_stringParams.begin();
-            std::vector<StringParam>::const_iterator itEnd = this->_stringParams.end();
-            for (; it != itEnd; ++it)
-                params.SetString(it->name, it->value);
-        }
+        if (id < 1 || id > this->_nbTasks)
+            return false;
+        Point point;
+        this->_IndexToPoint(this->_validIndexes.empty() ? id - 1 : this->_validIndexes[id - 1], point);
+        params.SetId(id);
+        this->_WriteParams(point, params);
+        return true;
     }
 }
@@ -30,44 +30,28 @@
 #ifndef __BACKTESTER_PARAMSGENERATORCOMPLETE__
 #define __BACKTESTER_PARAMSGENERATORCOMPLETE__
 
-#include "ParamsGenerator.hpp"
+#include "ParamsGeneratorGrid.hpp"
 
 namespace Backtester
 {
-    class TesterLogger;
-    class StratParamsMap;
-    class Conf;
-
     class ParamsGeneratorComplete :
-        public ParamsGenerator
+        public ParamsGeneratorGrid
     {
         public:
             explicit ParamsGeneratorComplete(Logger const& logger, Conf& conf);
             virtual bool Initialize();
             virtual bool GenerateNextParams(StratParamsMap& params);
+
+            /*
+               The id minus one is the index of the grid point (see _IndexToPoint()), or of the
+               points satisfying the constraints of the parameters file if any.
+            */
+            virtual bool GenerateParams(unsigned int id, StratParamsMap& params) const;
             virtual unsigned int GetNbTotalTasks() const;
         private:
-            struct FloatParam
-            {
-                std::string name;
-                float start;
-                float step;
-                unsigned int iterations;
-                float current;
-            };
-            struct StringParam
-            {
-                std::string name;
-                std::string value;
-            };
-            virtual bool _AddFloatParam(std::string const& name, float start, float step, unsigned int iterations);
-            virtual bool _AddStringParam(std::string const& name, std::string const& value);
-            void _WriteParams(StratParamsMap& params);
-            std::vector<FloatParam> _floatParams;
-            std::vector<StringParam> _stringParams;
-            bool _noMoreParams;
             unsigned int _nextParamId;
             unsigned int _nbTasks;
+            std::vector<unsigned int> _validIndexes; // grid indexes, only with constraints
     };
 }
 
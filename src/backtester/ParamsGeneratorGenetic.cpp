@@ -0,0 +1,206 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <ctime>
+#include <limits>
+#include "ParamsGeneratorGenetic.hpp"
+#include "StratParamsMap.hpp"
+#include "Report.hpp"
+#include "Logger.hpp"
+#include "Conf.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/ParamsGeneratorGenetic] "
+
+namespace Backtester
+{
+    namespace
+    {
+        ParamsGenerator* Create(Logger const& logger, Conf& conf, Core::History const&)
+        {
+            return new ParamsGeneratorGenetic(logger, conf);
+        }
+
+        ParamsGeneratorRegistry::Registrar registrar("genetic", &Create);
+    }
+
+    ParamsGeneratorGenetic::ParamsGeneratorGenetic(Logger const& logger, Conf& conf) :
+        ParamsGeneratorGrid("genetic", logger, conf),
+        _rng(conf.paramsSeed ? conf.paramsSeed : static_cast<unsigned int>(std::time(0))),
+        _generation(0), _nextIndividual(0), _nbTestedInGeneration(0), _nextParamId(0),
+        _bestId(0), _bestScore(-std::numeric_limits<float>::infinity())
+    {
+    }
+
+    bool ParamsGeneratorGenetic::Initialize()
+    {
+        if (!ParamsGeneratorGrid::Initialize())
+            return false;
+        this->_population.resize(this->_conf.geneticPopulation);
+        std::vector<Point>::iterator it = this->_population.begin();
+        std::vector<Point>::iterator itEnd = this->_population.end();
+        for (; it != itEnd; ++it)
+            this->_RandomPoint(*it);
+        this->_logger.Log(CLASS + Tools::ToString(this->_conf.geneticGenerations) + " generation" + (this->_conf.geneticGenerations > 1 ? "s" : "") + " of " + Tools::ToString(this->_population.size()) + " individuals.");
+        return true;
+    }
+
+    unsigned int ParamsGeneratorGenetic::GetNbTotalTasks() const
+    {
+        boost::uint64_t nbTasks = static_cast<boost::uint64_t>(this->_conf.geneticPopulation) * this->_conf.geneticGenerations;
+        return nbTasks < this->_GetGridSize() ? nbTasks : this->_GetGridSize();
+    }
+
+    bool ParamsGeneratorGenetic::IsWaitingForReports() const
+    {
+        return !this->_pendingIds.empty();
+    }
+
+    bool ParamsGeneratorGenetic::GenerateNextParams(StratParamsMap& params)
+    {
+        while (this->_generation < this->_conf.geneticGenerations)
+        {
+            while (this->_nextIndividual < this->_population.size())
+            {
+                Point const& point = this->_population[this->_nextIndividual++];
+                // same parameters as another individual
+                if (this->_fitness.count(point) || this->_pendingPoints.count(point))
+                    continue;
+                // not tested, the worst
+                if (!this->_IsValid(point))
+                {
+                    this->_fitness[point] = -std::numeric_limits<float>::infinity();
+                    continue;
+                }
+                params.SetId(++this->_nextParamId);
+                this->_WriteParams(point, params);
+                this->_pendingIds[this->_nextParamId] = point;
+                this->_pendingPoints.insert(point);
+                ++this->_nbTestedInGeneration;
+                return true;
+            }
+            if (!this->_pendingIds.empty())
+                return false;
+            this->_LogGeneration();
+            if (++this->_generation < this->_conf.geneticGenerations)
+                this->_Breed();
+        }
+        return false;
+    }
+
+    void ParamsGeneratorGenetic::ReportFeedback(Report const& report)
+    {
+        std::map<unsigned int, Point>::iterator it = this->_pendingIds.find(report.GetParams().GetId());
+        if (it == this->_pendingIds.end())
+            return;
+        // failed and pruned parameters are the worst
+        float score = report.HasFailed() || report.IsPruned() ? -std::numeric_limits<float>::infinity() : report.GetScore();
+        this->_fitness[it->second] = score;
+        if (this->_best.empty() || score > this->_bestScore)
+        {
+            this->_best = it->second;
+            this->_bestId = it->first;
+            this->_bestScore = score;
+        }
+        this->_pendingPoints.erase(it->second);
+        this->_pendingIds.erase(it);
+    }
+
+    void ParamsGeneratorGenetic::_RandomPoint(Point& point)
+    {
+        point.resize(this->_floatParams.size());
+        for (unsigned int i = 0; i < this->_floatParams.size(); ++i)
+            point[i] = std::uniform_int_distribution<unsigned int>(0, this->_floatParams[i].iterations - 1)(this->_rng);
+    }
+
+    float ParamsGeneratorGenetic::_GetFitness(Point const& point) const
+    {
+        std::map<Point, float>::const_iterator it = this->_fitness.find(point);
+        if (it == this->_fitness.end())
+            return -std::numeric_limits<float>::infinity();
+        return it->second;
+    }
+
+    ParamsGeneratorGenetic::Point const& ParamsGeneratorGenetic::_Tournament()
+    {
+        std::uniform_int_distribution<unsigned int> pick(0, this->_population.size() - 1);
+        Point const* winner = &this->_population[pick(this->_rng)];
+        for (unsigned int i = 1; i < this->_conf.geneticTournament; ++i)
+        {
+            Point const& challenger = this->_population[pick(this->_rng)];
+            if (this->_GetFitness(challenger) > this->_GetFitness(*winner))
+                winner = &challenger;
+        }
+        return *winner;
+    }
+
+    void ParamsGeneratorGenetic::_Breed()
+    {
+        std::uniform_real_distribution<float> chance(0, 1);
+        std::vector<Point> children;
+        children.reserve(this->_population.size());
+        // elitism: the best parameters found so far survive
+        if (!this->_best.empty())
+            children.push_back(this->_best);
+        while (children.size() < this->_population.size())
+        {
+            Point child = this->_Tournament();
+            if (chance(this->_rng) < this->_conf.geneticCrossover)
+            {
+                Point const& other = this->_Tournament();
+                for (unsigned int i = 0; i < child.size(); ++i)
+                    if (chance(this->_rng) < 0.5)
+                        child[i] = other[i];
+            }
+            for (unsigned int i = 0; i < child.size(); ++i)
+                if (chance(this->_rng) < this->_conf.geneticMutation)
+                    child[i] = std::uniform_int_distribution<unsigned int>(0, this->_floatParams[i].iterations - 1)(this->_rng);
+            children.push_back(child);
+        }
+        this->_population.swap(children);
+        this->_nextIndividual = 0;
+        this->_nbTestedInGeneration = 0;
+    }
+
+    void ParamsGeneratorGenetic::_LogGeneration() const
+    {
+        std::string res = "Generation " + Tools::ToString(this->_generation + 1) + "/" + Tools::ToString(this->_conf.geneticGenerations) + ": " +
+            Tools::ToString(this->_nbTestedInGeneration) + " new individual" + (this->_nbTestedInGeneration > 1 ? "s" : "") + " tested, " +
+            Tools::ToString(this->_fitness.size()) + " in total";
+        if (this->_best.empty() || this->_bestScore == -std::numeric_limits<float>::infinity())
+        {
+            this->_logger.Log(CLASS + res + ", no successful report yet.");
+            return;
+        }
+        StratParamsMap best(this->_logger);
+        best.SetId(this->_bestId);
+        this->_WriteParams(this->_best, best);
+        this->_logger.Log(CLASS + res + ", best: " + best.GetFloatParamsString() + " Score " + Tools::ToString(this->_bestScore) + ".");
+    }
+}
@@ -0,0 +1,82 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_PARAMSGENERATORGENETIC__
+#define __BACKTESTER_PARAMSGENERATORGENETIC__
+
+#include <map>
+#include <set>
+#include <random>
+#include "ParamsGeneratorGrid.hpp"
+
+namespace Backtester
+{
+    /*
+       Genetic algorithm on the grid of the parameters file: geneticGenerations generations of
+       geneticPopulation individuals, the best one kept as is and the others bred by tournament
+       selection, uniform crossover and per-parameter mutation.
+       A generation is dispatched to all the threads at once, and the next one is bred when all its
+       reports are back (IsWaitingForReports() meanwhile). Points already tested are not tested again.
+    */
+    class ParamsGeneratorGenetic :
+        public ParamsGeneratorGrid
+    {
+        public:
+            explicit ParamsGeneratorGenetic(Logger const& logger, Conf& conf);
+            virtual bool Initialize();
+            virtual bool GenerateNextParams(StratParamsMap& params);
+            virtual void ReportFeedback(Report const& report);
+            virtual bool IsWaitingForReports() const;
+
+            /*
+               Upper bound: individuals already tested are skipped.
+            */
+            virtual unsigned int GetNbTotalTasks() const;
+        private:
+            void _RandomPoint(Point& point);
+            Point const& _Tournament();
+            void _Breed();
+            float _GetFitness(Point const& point) const;
+            void _LogGeneration() const;
+            std::mt19937 _rng;
+            std::vector<Point> _population;
+            unsigned int _generation;
+            unsigned int _nextIndividual;
+            unsigned int _nbTestedInGeneration;
+            unsigned int _nextParamId;
+            std::map<unsigned int, Point> _pendingIds;
+            std::set<Point> _pendingPoints;
+            std::map<Point, float> _fitness;
+            Point _best;
+            unsigned int _bestId;
+            float _bestScore;
+    };
+}
+
+#endif
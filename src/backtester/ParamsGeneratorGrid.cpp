@@ -0,0 +1,179 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <limits>
+#include "ParamsGeneratorGrid.hpp"
+#include "StratParamsMap.hpp"
+#include "Logger.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/ParamsGeneratorGrid] "
+
+namespace Backtester
+{
+    ParamsGeneratorGrid::ParamsGeneratorGrid(std::string const& name, Logger const& logger, Conf const& conf) :
+        ParamsGenerator(name, logger, conf), _gridSize(1), _slotsResolved(false), _nbFloatSlots(0), _nbStringSlots(0)
+    {
+    }
+
+    bool ParamsGeneratorGrid::Initialize()
+    {
+        if (this->_floatParams.size())
+        {
+            std::string floatRes = Tools::ToString(this->_floatParams.size()) + " parameter" + (this->_floatParams.size() > 1 ? "s" : "") + ".";
+            std::vector<FloatParam>::const_iterator it = this->_floatParams.begin();
+            std::vector<FloatParam>::const_iterator itEnd = this->_floatParams.end();
+            for (; it != itEnd; ++it)
+            {
+                floatRes += " \"" + it->name + "\" (" + Tools::ToString(it->start, 2) + ", " + Tools::ToString(it->step, 2) + ", " + Tools::ToString(it->iterations) + ")";
+                if (this->_gridSize > std::numeric_limits<boost::uint64_t>::max() / it->iterations)
+                {
+                    this->_logger.Log(CLASS "Too many parameter combinations.", ::Logger::Error);
+                    return false;
+                }
+                this->_gridSize *= it->iterations;
+            }
+            this->_logger.Log(CLASS + floatRes);
+        }
+        else
+            this->_logger.Log(CLASS "No parameters.");
+        if (this->_stringParams.size())
+        {
+            std::string stringRes = Tools::ToString(this->_stringParams.size()) + " string" + (this->_stringParams.size() > 1 ? "s" : "") + ".";
+            std::vector<StringParam>::const_iterator it = this->_stringParams.begin();
+            std::vector<StringParam>::const_iterator itEnd = this->_stringParams.end();
+            for (; it != itEnd; ++it)
+                stringRes += " \"" + it->name + "\" (" + Tools::ToString(it->value.size()) + ")";
+            this->_logger.Log(CLASS + stringRes);
+        }
+        else
+            this->_logger.Log(CLASS "No strings.");
+        return true;
+    }
+
+    bool ParamsGeneratorGrid::_AddFloatParam(std::string const& name, float start, float step, unsigned int iterations)
+    {
+        FloatParam p;
+        p.name = name;
+        p.start = start;
+        p.step = step;
+        p.iterations = iterations > 1 ? iterations : 1;
+        this->_floatParams.push_back(p);
+        return true;
+    }
+
+    bool ParamsGeneratorGrid::_AddStringParam(std::string const& name, std::string const& value)
+    {
+        StringParam p;
+        p.name = name;
+        p.value = value;
+        this->_stringParams.push_back(p);
+        return true;
+    }
+
+    boost::uint64_t ParamsGeneratorGrid::_GetGridSize() const
+    {
+        return this->_gridSize;
+    }
+
+    void ParamsGeneratorGrid::_IndexToPoint(boost::uint64_t index, Point& point) const
+    {
+        point.resize(this->_floatParams.size());
+        for (unsigned int i = this->_floatParams.size(); i > 0; --i)
+        {
+            point[i - 1] = index % this->_floatParams[i - 1].iterations;
+            index /= this->_floatParams[i - 1].iterations;
+        }
+    }
+
+    boost::uint64_t ParamsGeneratorGrid::_PointToIndex(Point const& point) const
+    {
+        boost::uint64_t index = 0;
+        for (unsigned int i = 0; i < this->_floatParams.size(); ++i)
+            index = index * this->_floatParams[i].iterations + point[i];
+        return index;
+    }
+
+    bool ParamsGeneratorGrid::_IsValid(Point const& point)
+    {
+        if (!this->_HasConstraints())
+            return true;
+        for (unsigned int i = 0; i < this->_floatParams.size(); ++i)
+        {
+            FloatParam const& p = this->_floatParams[i];
+            this->_SetConstraintValue(p.name, p.start + p.step * static_cast<float>(point[i]));
+        }
+        return this->_CheckConstraints();
+    }
+
+    bool ParamsGeneratorGrid::_HasSlots(StratParamsMap const& params) const
+    {
+        if (!params.GetNbFloatSlots() && !params.GetNbStringSlots()) // strategy not instantiated yet
+            return false;
+        if (!this->_slotsResolved)
+        {
+            this->_nbFloatSlots = params.GetNbFloatSlots();
+            this->_nbStringSlots = params.GetNbStringSlots();
+            this->_floatSlots.resize(this->_floatParams.size());
+            for (unsigned int i = 0; i < this->_floatParams.size(); ++i)
+                if (!params.FindFloatSlot(this->_floatParams[i].name, this->_floatSlots[i]))
+                    this->_floatSlots[i] = this->_nbFloatSlots;
+            this->_stringSlots.resize(this->_stringParams.size());
+            for (unsigned int i = 0; i < this->_stringParams.size(); ++i)
+                if (!params.FindStringSlot(this->_stringParams[i].name, this->_stringSlots[i]))
+                    this->_stringSlots[i] = this->_nbStringSlots;
+            this->_slotsResolved = true;
+        }
+        return params.GetNbFloatSlots() == this->_nbFloatSlots && params.GetNbStringSlots() == this->_nbStringSlots;
+    }
+
+    void ParamsGeneratorGrid::_WriteParams(Point const& point, StratParamsMap& params) const
+    {
+        if (this->_HasSlots(params))
+        {
+            for (unsigned int i = 0; i < this->_floatParams.size(); ++i)
+            {
+                FloatParam const& p = this->_floatParams[i];
+                params.SetFloat(p.name, this->_floatSlots[i], p.start + p.step * static_cast<float>(point[i])); // no accumulated error
+            }
+            for (unsigned int i = 0; i < this->_stringParams.size(); ++i)
+                params.SetString(this->_stringParams[i].name, this->_stringSlots[i], this->_stringParams[i].value);
+            return;
+        }
+        for (unsigned int i = 0; i < this->_floatParams.size(); ++i)
+        {
+            FloatParam const& p = this->_floatParams[i];
+            params.SetFloat(p.name, p.start + p.step * static_cast<float>(point[i])); // no accumulated error
+        }
+        std::vector<StringParam>::const_iterator it = this->_stringParams.begin();
+        std::vector<StringParam>::const_iterator itEnd = this->_stringParams.end();
+        for (; it != itEnd; ++it)
+            params.SetString(it->name, it->value);
+    }
+}
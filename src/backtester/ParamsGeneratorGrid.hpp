@@ -0,0 +1,103 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_PARAMSGENERATORGRID__
+#define __BACKTESTER_PARAMSGENERATORGRID__
+
+#include <vector>
+#include <boost/cstdint.hpp>
+#include "ParamsGenerator.hpp"
+
+namespace Backtester
+{
+    /*
+       Base of the generators exploring the grid of the parameters file: each float parameter
+       takes the values start + step * i, with i from 0 to iterations - 1.
+       It parses and logs the parameters file and maps grid points to and from their index, so
+       that the complete, genetic and random (and derived) generators address the same points.
+    */
+    class ParamsGeneratorGrid :
+        public ParamsGenerator
+    {
+        public:
+            ParamsGeneratorGrid(std::string const& name, Logger const& logger, Conf const& conf);
+            virtual bool Initialize();
+        protected:
+            struct FloatParam
+            {
+                std::string name;
+                float start;
+                float step;
+                unsigned int iterations;
+            };
+            struct StringParam
+            {
+                std::string name;
+                std::string value;
+            };
+
+            /*
+               A point of the grid: one step index per float parameter.
+            */
+            typedef std::vector<unsigned int> Point;
+
+            /*
+               Writes the values of the point in params, and in their slots once the strategy declared them: the
+               slots are resolved from the first parameters with declared slots, then reused for the parameters
+               with the same number of slots (the generators are called with the mutex of the backtester locked).
+            */
+            void _WriteParams(Point const& point, StratParamsMap& params) const;
+
+            /*
+               True if the point satisfies the constraints of the parameters file.
+            */
+            bool _IsValid(Point const& point);
+
+            /*
+               The index is a mixed-radix number: one digit per float parameter (the last one changes first).
+            */
+            void _IndexToPoint(boost::uint64_t index, Point& point) const;
+            boost::uint64_t _PointToIndex(Point const& point) const;
+            boost::uint64_t _GetGridSize() const;
+            std::vector<FloatParam> _floatParams;
+            std::vector<StringParam> _stringParams;
+        private:
+            virtual bool _AddFloatParam(std::string const& name, float start, float step, unsigned int iterations);
+            virtual bool _AddStringParam(std::string const& name, std::string const& value);
+            bool _HasSlots(StratParamsMap const& params) const;
+            boost::uint64_t _gridSize;
+            mutable bool _slotsResolved;
+            mutable unsigned int _nbFloatSlots;
+            mutable unsigned int _nbStringSlots;
+            mutable std::vector<unsigned int> _floatSlots; // of each float parameter, _nbFloatSlots if not declared
+            mutable std::vector<unsigned int> _stringSlots;
+    };
+}
+
+#endif
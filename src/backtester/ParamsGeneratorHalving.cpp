@@ -0,0 +1,148 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include "ParamsGeneratorHalving.hpp"
+#include "StratParamsMap.hpp"
+#include "Report.hpp"
+#include "Logger.hpp"
+#include "Conf.hpp"
+#include "core/History.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/ParamsGeneratorHalving] "
+
+namespace Backtester
+{
+    namespace
+    {
+        ParamsGenerator* Create(Logger const& logger, Conf& conf, Core::History const& history)
+        {
+            return new ParamsGeneratorHalving(logger, conf, history);
+        }
+
+        ParamsGeneratorRegistry::Registrar registrar("halving", &Create);
+    }
+
+    ParamsGeneratorHalving::ParamsGeneratorHalving(Logger const& logger, Conf& conf, Core::History const& history) :
+        ParamsGeneratorRandom("halving", logger, conf), _history(history), _nbTotalTasks(0), _rung(0), _nextCandidate(0), _nextParamId(0)
+    {
+    }
+
+    bool ParamsGeneratorHalving::Initialize()
+    {
+        if (!ParamsGeneratorRandom::Initialize())
+            return false;
+        unsigned int nbBars = this->_history.GetBars().size();
+        float fraction = this->_conf.halvingMinHistory / 100;
+        unsigned int nbCandidates = this->_points.size();
+        while (true)
+        {
+            Rung r;
+            r.nbCandidates = nbCandidates;
+            r.historyEnd = fraction < 1 ? static_cast<unsigned int>(nbBars * fraction) : 0;
+            this->_rungs.push_back(r);
+            this->_nbTotalTasks += nbCandidates;
+            this->_logger.Log(CLASS "Rung " + Tools::ToString(this->_rungs.size()) + ": " + Tools::ToString(nbCandidates) + " candidate" + (nbCandidates > 1 ? "s" : "") +
+                    " on " + (r.historyEnd ? Tools::ToString(fraction * 100, 2) + "% of the history (" + Tools::ToString(r.historyEnd) + " bars)." : std::string("the whole history.")));
+            if (!r.historyEnd)
+                break;
+            fraction *= this->_conf.halvingRate;
+            nbCandidates = (nbCandidates + this->_conf.halvingRate - 1) / this->_conf.halvingRate;
+        }
+        for (unsigned int i = 0; i < this->_points.size(); ++i)
+            this->_candidates.push_back(i);
+        return true;
+    }
+
+    unsigned int ParamsGeneratorHalving::GetNbTotalTasks() const
+    {
+        return this->_nbTotalTasks;
+    }
+
+    bool ParamsGeneratorHalving::IsWaitingForReports() const
+    {
+        return !this->_pendingIds.empty();
+    }
+
+    bool ParamsGeneratorHalving::GenerateParams(unsigned int, StratParamsMap&) const
+    {
+        // the candidates of a rung depend on the reports of the previous one
+        return false;
+    }
+
+    bool ParamsGeneratorHalving::GenerateNextParams(StratParamsMap& params)
+    {
+        while (this->_rung < this->_rungs.size())
+        {
+            if (this->_nextCandidate < this->_candidates.size())
+            {
+                unsigned int candidate = this->_candidates[this->_nextCandidate++];
+                params.SetId(++this->_nextParamId);
+                params.SetHistoryRange(0, this->_rungs[this->_rung].historyEnd);
+                this->_WriteParams(this->_points[candidate], params);
+                this->_pendingIds[this->_nextParamId] = candidate;
+                return true;
+            }
+            if (!this->_pendingIds.empty())
+                return false;
+            std::sort(this->_scores.begin(), this->_scores.end(), std::greater<std::pair<float, unsigned int> >());
+            if (!this->_scores.empty() && this->_scores.front().first != -std::numeric_limits<float>::infinity())
+            {
+                StratParamsMap best(this->_logger);
+                this->_WriteParams(this->_points[this->_scores.front().second], best);
+                this->_logger.Log(CLASS "Rung " + Tools::ToString(this->_rung + 1) + "/" + Tools::ToString(this->_rungs.size()) + " finished, best: " +
+                        best.GetFloatParamsString() + " Score " + Tools::ToString(this->_scores.front().first) + ".");
+            }
+            else
+                this->_logger.Log(CLASS "Rung " + Tools::ToString(this->_rung + 1) + "/" + Tools::ToString(this->_rungs.size()) + " finished, no successful report.");
+            if (++this->_rung >= this->_rungs.size())
+                break;
+            this->_candidates.clear();
+            for (unsigned int i = 0; i < this->_scores.size() && i < this->_rungs[this->_rung].nbCandidates; ++i)
+                this->_candidates.push_back(this->_scores[i].second);
+            this->_scores.clear();
+            this->_nextCandidate = 0;
+        }
+        return false;
+    }
+
+    void ParamsGeneratorHalving::ReportFeedback(Report const& report)
+    {
+        std::map<unsigned int, unsigned int>::iterator it = this->_pendingIds.find(report.GetParams().GetId());
+        if (it == this->_pendingIds.end())
+            return;
+        // failed and pruned candidates are the worst
+        float score = report.HasFailed() || report.IsPruned() ? -std::numeric_limits<float>::infinity() : report.GetScore();
+        this->_scores.push_back(std::make_pair(score, it->second));
+        this->_pendingIds.erase(it);
+    }
+}
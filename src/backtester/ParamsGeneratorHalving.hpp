@@ -0,0 +1,78 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_PARAMSGENERATORHALVING__
+#define __BACKTESTER_PARAMSGENERATORHALVING__
+
+#include <map>
+#include "ParamsGeneratorRandom.hpp"
+
+namespace Core
+{
+    class History;
+}
+
+namespace Backtester
+{
+    /*
+       Successive halving: the paramsBudget candidates of the random generator are first tested
+       on the first halvingMinHistory percent of the history, then the best 1/halvingRate of them
+       on halvingRate times more history, and so on until the finalists run the whole history.
+       A rung waits for all its reports (IsWaitingForReports()) before selecting the next one.
+    */
+    class ParamsGeneratorHalving :
+        public ParamsGeneratorRandom
+    {
+        public:
+            explicit ParamsGeneratorHalving(Logger const& logger, Conf& conf, Core::History const& history);
+            virtual bool Initialize();
+            virtual bool GenerateNextParams(StratParamsMap& params);
+            virtual bool GenerateParams(unsigned int id, StratParamsMap& params) const;
+            virtual void ReportFeedback(Report const& report);
+            virtual bool IsWaitingForReports() const;
+            virtual unsigned int GetNbTotalTasks() const;
+        private:
+            struct Rung
+            {
+                unsigned int nbCandidates;
+                unsigned int historyEnd; // 0 for the whole history
+            };
+            Core::History const& _history;
+            std::vector<Rung> _rungs;
+            unsigned int _nbTotalTasks;
+            unsigned int _rung;
+            std::vector<unsigned int> _candidates; // indexes in _points
+            unsigned int _nextCandidate;
+            unsigned int _nextParamId;
+            std::map<unsigned int, unsigned int> _pendingIds; // candidate by id
+            std::vector<std::pair<float, unsigned int> > _scores; // of the current rung
+    };
+}
+
+#endif
@@ -0,0 +1,77 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include "ParamsGeneratorLhs.hpp"
+
+namespace Backtester
+{
+    namespace
+    {
+        ParamsGenerator* Create(Logger const& logger, Conf& conf, Core::History const&)
+        {
+            return new ParamsGeneratorLhs(logger, conf);
+        }
+
+        ParamsGeneratorRegistry::Registrar registrar("lhs", &Create);
+    }
+
+    ParamsGeneratorLhs::ParamsGeneratorLhs(Logger const& logger, Conf& conf) :
+        ParamsGeneratorRandom("lhs", logger, conf)
+    {
+    }
+
+    ParamsGeneratorLhs::ParamsGeneratorLhs(std::string const& name, Logger const& logger, Conf& conf) :
+        ParamsGeneratorRandom(name, logger, conf)
+    {
+    }
+
+    void ParamsGeneratorLhs::_DrawPoints(unsigned int nb)
+    {
+        std::uniform_real_distribution<double> offset(0, 1);
+        std::vector<Point> points(nb, Point(this->_floatParams.size()));
+        std::vector<unsigned int> strata(nb);
+        for (unsigned int p = 0; p < this->_floatParams.size(); ++p)
+        {
+            for (unsigned int i = 0; i < nb; ++i)
+                strata[i] = i;
+            std::shuffle(strata.begin(), strata.end(), this->_rng);
+            double iterations = this->_floatParams[p].iterations;
+            for (unsigned int i = 0; i < nb; ++i)
+            {
+                unsigned int digit = static_cast<unsigned int>((strata[i] + offset(this->_rng)) * iterations / nb);
+                points[i][p] = std::min(digit, this->_floatParams[p].iterations - 1);
+            }
+        }
+        std::vector<Point>::const_iterator it = points.begin();
+        std::vector<Point>::const_iterator itEnd = points.end();
+        for (; it != itEnd; ++it)
+            this->_AddPoint(*it);
+    }
+}
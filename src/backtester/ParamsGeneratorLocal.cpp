@@ -0,0 +1,209 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <limits>
+#include "ParamsGeneratorLocal.hpp"
+#include "StratParamsMap.hpp"
+#include "Report.hpp"
+#include "Logger.hpp"
+#include "Conf.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/ParamsGeneratorLocal] "
+
+namespace Backtester
+{
+    namespace
+    {
+        ParamsGenerator* Create(Logger const& logger, Conf& conf, Core::History const&)
+        {
+            return new ParamsGeneratorLocal(logger, conf);
+        }
+
+        ParamsGeneratorRegistry::Registrar registrar("local", &Create);
+    }
+
+    ParamsGeneratorLocal::ParamsGeneratorLocal(Logger const& logger, Conf& conf) :
+        ParamsGeneratorLhs("local", logger, conf), _nbGenerated(0), _nbPending(0), _started(false), _center(0)
+    {
+    }
+
+    unsigned int ParamsGeneratorLocal::_GetNbInitialPoints() const
+    {
+        return this->_conf.localInitial;
+    }
+
+    bool ParamsGeneratorLocal::Initialize()
+    {
+        if (!ParamsGeneratorLhs::Initialize())
+            return false;
+        // start values
+        if (this->_points.empty() && !this->_AddPoint(Point(this->_floatParams.size(), 0)))
+        {
+            this->_logger.Log(CLASS "The start values do not satisfy the constraints.", ::Logger::Error);
+            return false;
+        }
+        for (unsigned int i = 0; i < this->_points.size(); ++i)
+            this->_pointIndexes[this->_PointToIndex(this->_points[i])] = i;
+        return true;
+    }
+
+    unsigned int ParamsGeneratorLocal::GetNbTotalTasks() const
+    {
+        return this->_GetGridSize() < this->_conf.paramsBudget ? this->_GetGridSize() : this->_conf.paramsBudget;
+    }
+
+    bool ParamsGeneratorLocal::IsWaitingForReports() const
+    {
+        return this->_nbPending;
+    }
+
+    bool ParamsGeneratorLocal::GenerateNextParams(StratParamsMap& params)
+    {
+        while (this->_nbGenerated >= this->_points.size())
+        {
+            // a move needs the scores of all the neighbours
+            if (this->_nbPending || !this->_Move())
+                return false;
+        }
+        if (!this->GenerateParams(this->_nbGenerated + 1, params))
+            return false;
+        ++this->_nbGenerated;
+        ++this->_nbPending;
+        return true;
+    }
+
+    void ParamsGeneratorLocal::ReportFeedback(Report const& report)
+    {
+        unsigned int id = report.GetParams().GetId();
+        if (id < 1 || id > this->_nbGenerated || this->_scores.count(id - 1))
+            return;
+        // failed and pruned points are the worst
+        this->_scores[id - 1] = report.HasFailed() || report.IsPruned() ? -std::numeric_limits<float>::infinity() : report.GetScore();
+        --this->_nbPending;
+    }
+
+    float ParamsGeneratorLocal::_GetScore(unsigned int index) const
+    {
+        std::map<unsigned int, float>::const_iterator it = this->_scores.find(index);
+        if (it == this->_scores.end())
+            return -std::numeric_limits<float>::infinity();
+        return it->second;
+    }
+
+    bool ParamsGeneratorLocal::_Move()
+    {
+        if (!this->_started)
+        {
+            // best starting point
+            this->_started = true;
+            for (unsigned int i = 1; i < this->_points.size(); ++i)
+                if (this->_GetScore(i) > this->_GetScore(this->_center))
+                    this->_center = i;
+            if (this->_GetScore(this->_center) == -std::numeric_limits<float>::infinity())
+            {
+                this->_logger.Log(CLASS "No successful starting point, stopping.", ::Logger::Warning);
+                return false;
+            }
+            std::vector<FloatParam>::const_iterator it = this->_floatParams.begin();
+            std::vector<FloatParam>::const_iterator itEnd = this->_floatParams.end();
+            for (; it != itEnd; ++it)
+                this->_distances.push_back((it->iterations + 3) / 4);
+            this->_LogCenter("Starting from");
+        }
+        else
+        {
+            unsigned int best = this->_center;
+            std::vector<unsigned int>::const_iterator it = this->_neighbours.begin();
+            std::vector<unsigned int>::const_iterator itEnd = this->_neighbours.end();
+            for (; it != itEnd; ++it)
+                if (this->_GetScore(*it) > this->_GetScore(best))
+                    best = *it;
+            if (best != this->_center)
+            {
+                this->_center = best;
+                this->_LogCenter("Moving to");
+            }
+            else
+            {
+                bool shrunk = false;
+                std::vector<unsigned int>::iterator distance = this->_distances.begin();
+                std::vector<unsigned int>::iterator distanceEnd = this->_distances.end();
+                for (; distance != distanceEnd; ++distance)
+                    if (*distance > 1)
+                    {
+                        *distance /= 2;
+                        shrunk = true;
+                    }
+                if (!shrunk)
+                {
+                    this->_LogCenter("Converged at");
+                    return false;
+                }
+            }
+        }
+
+        // neighbours along each parameter, already tested or not
+        this->_neighbours.clear();
+        Point const center = this->_points[this->_center];
+        for (unsigned int i = 0; i < center.size(); ++i)
+            for (int direction = -1; direction <= 1; direction += 2)
+            {
+                int digit = static_cast<int>(center[i]) + direction * static_cast<int>(this->_distances[i]);
+                if (digit < 0 || digit >= static_cast<int>(this->_floatParams[i].iterations))
+                    continue;
+                Point neighbour = center;
+                neighbour[i] = digit;
+                boost::uint64_t index = this->_PointToIndex(neighbour);
+                std::map<boost::uint64_t, unsigned int>::const_iterator known = this->_pointIndexes.find(index);
+                if (known != this->_pointIndexes.end())
+                    this->_neighbours.push_back(known->second);
+                else if (this->_points.size() < this->_conf.paramsBudget && this->_AddPoint(neighbour))
+                {
+                    this->_pointIndexes[index] = this->_points.size() - 1;
+                    this->_neighbours.push_back(this->_points.size() - 1);
+                }
+            }
+        return true;
+    }
+
+    void ParamsGeneratorLocal::_LogCenter(std::string const& message) const
+    {
+        StratParamsMap center(this->_logger);
+        center.SetId(this->_center + 1);
+        this->_WriteParams(this->_points[this->_center], center);
+        std::string distances;
+        std::vector<unsigned int>::const_iterator it = this->_distances.begin();
+        std::vector<unsigned int>::const_iterator itEnd = this->_distances.end();
+        for (; it != itEnd; ++it)
+            distances += (distances.empty() ? "" : "/") + Tools::ToString(*it);
+        this->_logger.Log(CLASS + message + " " + center.GetFloatParamsString() + " Score " + Tools::ToString(this->_GetScore(this->_center)) +
+                " (distances " + distances + " steps, " + Tools::ToString(this->_scores.size()) + " points tested).");
+    }
+}
@@ -0,0 +1,75 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_PARAMSGENERATORLOCAL__
+#define __BACKTESTER_PARAMSGENERATORLOCAL__
+
+#include <map>
+#include "ParamsGeneratorLhs.hpp"
+
+namespace Backtester
+{
+    /*
+       Local search (compass search) on the grid: starts from the best of localInitial Latin
+       hypercube points (the start values if 0) and tests its neighbours along each parameter,
+       a quarter of the grid away. It moves to the best neighbour if it improves the score,
+       otherwise the distance is halved, until it is one step and nothing improves.
+       The neighbours of a move are tested in parallel. At most paramsBudget points are tested.
+    */
+    class ParamsGeneratorLocal :
+        public ParamsGeneratorLhs
+    {
+        public:
+            explicit ParamsGeneratorLocal(Logger const& logger, Conf& conf);
+            virtual bool Initialize();
+            virtual bool GenerateNextParams(StratParamsMap& params);
+            virtual void ReportFeedback(Report const& report);
+            virtual bool IsWaitingForReports() const;
+
+            /*
+               Upper bound: the search usually stops before the budget.
+            */
+            virtual unsigned int GetNbTotalTasks() const;
+        private:
+            virtual unsigned int _GetNbInitialPoints() const;
+            bool _Move();
+            float _GetScore(unsigned int index) const;
+            void _LogCenter(std::string const& message) const;
+            unsigned int _nbGenerated;
+            std::map<boost::uint64_t, unsigned int> _pointIndexes; // by grid index
+            std::map<unsigned int, float> _scores; // by point index
+            unsigned int _nbPending;
+            bool _started;
+            unsigned int _center; // point index
+            std::vector<unsigned int> _distances; // in steps, by parameter
+            std::vector<unsigned int> _neighbours; // point indexes
+    };
+}
+
+#endif
@@ -0,0 +1,170 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <ctime>
+#include "ParamsGeneratorRandom.hpp"
+#include "StratParamsMap.hpp"
+#include "Logger.hpp"
+#include "Conf.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/ParamsGeneratorRandom] "
+
+namespace
+{
+    unsigned int const MaxDrawsPerPoint = 100;
+}
+
+namespace Backtester
+{
+    namespace
+    {
+        ParamsGenerator* Create(Logger const& logger, Conf& conf, Core::History const&)
+        {
+            return new ParamsGeneratorRandom(logger, conf);
+        }
+
+        ParamsGeneratorRegistry::Registrar registrar("random", &Create);
+    }
+
+    ParamsGeneratorRandom::ParamsGeneratorRandom(Logger const& logger, Conf& conf) :
+        ParamsGeneratorGrid("random", logger, conf),
+        _rng(conf.paramsSeed ? conf.paramsSeed : static_cast<unsigned int>(std::time(0))),
+        _nextParamId(0)
+    {
+    }
+
+    ParamsGeneratorRandom::ParamsGeneratorRandom(std::string const& name, Logger const& logger, Conf& conf) :
+        ParamsGeneratorGrid(name, logger, conf),
+        _rng(conf.paramsSeed ? conf.paramsSeed : static_cast<unsigned int>(std::time(0))),
+        _nextParamId(0)
+    {
+    }
+
+    bool ParamsGeneratorRandom::Initialize()
+    {
+        if (!ParamsGeneratorGrid::Initialize())
+            return false;
+        if (this->_GetGridSize() <= this->_conf.paramsBudget)
+        {
+            this->_logger.Log(CLASS "Budget of " + Tools::ToString(this->_conf.paramsBudget) + " covering the whole grid, testing every valid combination.");
+            Point point;
+            for (boost::uint64_t i = 0; i < this->_GetGridSize(); ++i)
+            {
+                this->_IndexToPoint(i, point);
+                this->_AddPoint(point);
+            }
+            if (this->_points.empty())
+            {
+                this->_logger.Log(CLASS "No parameter combination satisfies the constraints.", ::Logger::Error);
+                return false;
+            }
+            return true;
+        }
+        unsigned int nbPoints = this->_GetNbInitialPoints();
+        this->_points.reserve(nbPoints);
+        this->_DrawPoints(nbPoints);
+        // replace the duplicates and the points not satisfying the constraints
+        Point point;
+        for (unsigned int draws = 0; this->_points.size() < nbPoints; ++draws)
+        {
+            if (draws >= MaxDrawsPerPoint * nbPoints)
+            {
+                if (this->_points.empty())
+                {
+                    this->_logger.Log(CLASS "No parameter combination satisfying the constraints found.", ::Logger::Error);
+                    return false;
+                }
+                this->_logger.Log(CLASS "Only " + Tools::ToString(this->_points.size()) + " points satisfying the constraints found.", ::Logger::Warning);
+                break;
+            }
+            this->_DrawUniformPoint(point);
+            this->_AddPoint(point);
+        }
+        this->_logger.Log(CLASS + Tools::ToString(this->_points.size()) + " points drawn out of " + Tools::ToString(this->_GetGridSize()) + ".");
+        return true;
+    }
+
+    void ParamsGeneratorRandom::_DrawPoints(unsigned int nb)
+    {
+        Point point;
+        for (unsigned int i = 0; i < nb; ++i)
+        {
+            this->_DrawUniformPoint(point);
+            this->_AddPoint(point);
+        }
+    }
+
+    void ParamsGeneratorRandom::_DrawUniformPoint(Point& point)
+    {
+        point.resize(this->_floatParams.size());
+        for (unsigned int i = 0; i < point.size(); ++i)
+            point[i] = std::uniform_int_distribution<unsigned int>(0, this->_floatParams[i].iterations - 1)(this->_rng);
+    }
+
+    unsigned int ParamsGeneratorRandom::_GetNbInitialPoints() const
+    {
+        return this->_conf.paramsBudget;
+    }
+
+    bool ParamsGeneratorRandom::_HasPoint(Point const& point) const
+    {
+        return this->_indexes.count(this->_PointToIndex(point));
+    }
+
+    bool ParamsGeneratorRandom::_AddPoint(Point const& point)
+    {
+        if (!this->_indexes.insert(this->_PointToIndex(point)).second || !this->_IsValid(point))
+            return false;
+        this->_points.push_back(point);
+        return true;
+    }
+
+    unsigned int ParamsGeneratorRandom::GetNbTotalTasks() const
+    {
+        return this->_points.size();
+    }
+
+    bool ParamsGeneratorRandom::GenerateNextParams(StratParamsMap& params)
+    {
+        if (!this->GenerateParams(this->_nextParamId + 1, params))
+            return false;
+        ++this->_nextParamId;
+        return true;
+    }
+
+    bool ParamsGeneratorRandom::GenerateParams(unsigned int id, StratParamsMap& params) const
+    {
+        if (id < 1 || id > this->_points.size())
+            return false;
+        params.SetId(id);
+        this->_WriteParams(this->_points[id - 1], params);
+        return true;
+    }
+}
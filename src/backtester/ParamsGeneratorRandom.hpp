@@ -0,0 +1,84 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_PARAMSGENERATORRANDOM__
+#define __BACKTESTER_PARAMSGENERATORRANDOM__
+
+#include <set>
+#include <random>
+#include "ParamsGeneratorGrid.hpp"
+
+namespace Backtester
+{
+    /*
+       Draws paramsBudget distinct points of the grid, uniformly at random (the whole grid if it
+       is not larger than the budget). The points are drawn in Initialize(), so the ids support
+       random access.
+    */
+    class ParamsGeneratorRandom :
+        public ParamsGeneratorGrid
+    {
+        public:
+            explicit ParamsGeneratorRandom(Logger const& logger, Conf& conf);
+            virtual bool Initialize();
+            virtual bool GenerateNextParams(StratParamsMap& params);
+            virtual bool GenerateParams(unsigned int id, StratParamsMap& params) const;
+            virtual unsigned int GetNbTotalTasks() const;
+        protected:
+            ParamsGeneratorRandom(std::string const& name, Logger const& logger, Conf& conf);
+
+            /*
+               Number of points drawn by Initialize() when the grid is larger than the budget.
+            */
+            virtual unsigned int _GetNbInitialPoints() const;
+
+            /*
+               Appends up to nb new points, skipping the ones already in _points.
+            */
+            virtual void _DrawPoints(unsigned int nb);
+            void _DrawUniformPoint(Point& point);
+
+            /*
+               True if the point was given to _AddPoint(), even if it did not satisfy the constraints.
+            */
+            bool _HasPoint(Point const& point) const;
+
+            /*
+               Appends the point if it is new and satisfies the constraints.
+            */
+            bool _AddPoint(Point const& point);
+            std::mt19937 _rng;
+            std::vector<Point> _points;
+        private:
+            std::set<boost::uint64_t> _indexes;
+            unsigned int _nextParamId;
+    };
+}
+
+#endif
@@ -0,0 +1,210 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <limits>
+#include "ParamsGeneratorSurrogate.hpp"
+#include "StratParamsMap.hpp"
+#include "Report.hpp"
+#include "Logger.hpp"
+#include "Conf.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/ParamsGeneratorSurrogate] "
+
+namespace
+{
+    unsigned int const NbRandomCandidates = 1000;
+    unsigned int const NbLocalCandidates = 500;
+}
+
+namespace Backtester
+{
+    namespace
+    {
+        ParamsGenerator* Create(Logger const& logger, Conf& conf, Core::History const&)
+        {
+            return new ParamsGeneratorSurrogate(logger, conf);
+        }
+
+        ParamsGeneratorRegistry::Registrar registrar("surrogate", &Create);
+    }
+
+    ParamsGeneratorSurrogate::ParamsGeneratorSurrogate(Logger const& logger, Conf& conf) :
+        ParamsGeneratorLhs("surrogate", logger, conf), _nbGenerated(0), _bestScore(-std::numeric_limits<float>::infinity())
+    {
+    }
+
+    unsigned int ParamsGeneratorSurrogate::_GetNbInitialPoints() const
+    {
+        return this->_conf.surrogateInitial;
+    }
+
+    unsigned int ParamsGeneratorSurrogate::GetNbTotalTasks() const
+    {
+        return this->_GetGridSize() < this->_conf.paramsBudget ? this->_GetGridSize() : this->_conf.paramsBudget;
+    }
+
+    bool ParamsGeneratorSurrogate::IsWaitingForReports() const
+    {
+        return !this->_pendingIds.empty();
+    }
+
+    bool ParamsGeneratorSurrogate::GenerateNextParams(StratParamsMap& params)
+    {
+        if (this->_nbGenerated >= this->_points.size())
+        {
+            if (this->_points.size() >= this->GetNbTotalTasks())
+                return false;
+            // one point per free thread (local or of the workers)
+            if (this->_pendingIds.size() >= this->_conf.surrogateParallel)
+                return false;
+            if (!this->_Propose())
+                return false;
+        }
+        if (!this->GenerateParams(this->_nbGenerated + 1, params))
+            return false;
+        ++this->_nbGenerated;
+        this->_pendingIds[this->_nbGenerated] = this->_nbGenerated - 1;
+        return true;
+    }
+
+    void ParamsGeneratorSurrogate::ReportFeedback(Report const& report)
+    {
+        std::map<unsigned int, unsigned int>::iterator it = this->_pendingIds.find(report.GetParams().GetId());
+        if (it == this->_pendingIds.end())
+            return;
+        // failed and pruned points are the worst
+        float score = report.HasFailed() || report.IsPruned() ? -std::numeric_limits<float>::infinity() : report.GetScore();
+        this->_scores.push_back(std::make_pair(it->second, score));
+        if (score > this->_bestScore)
+        {
+            this->_bestScore = score;
+            this->_logger.Log(CLASS "New best after " + Tools::ToString(this->_scores.size()) + " backtests: " + report.GetParams().GetFloatParamsString() + " Score " + Tools::ToString(score) + ".");
+        }
+        this->_pendingIds.erase(it);
+    }
+
+    void ParamsGeneratorSurrogate::_PointToInput(Point const& point, GaussianProcess::Input& input) const
+    {
+        input.resize(point.size());
+        for (unsigned int i = 0; i < point.size(); ++i)
+            input[i] = this->_floatParams[i].iterations > 1 ? point[i] / static_cast<double>(this->_floatParams[i].iterations - 1) : 0.5;
+    }
+
+    bool ParamsGeneratorSurrogate::_Propose()
+    {
+        Point point;
+        std::vector<GaussianProcess::Input> inputs;
+        std::vector<double> outputs;
+        GaussianProcess::Input input;
+        double worst = std::numeric_limits<double>::infinity();
+        double sum = 0;
+        unsigned int nbScores = 0;
+        std::vector<std::pair<unsigned int, float> >::const_iterator it = this->_scores.begin();
+        std::vector<std::pair<unsigned int, float> >::const_iterator itEnd = this->_scores.end();
+        for (; it != itEnd; ++it)
+            if (it->second != -std::numeric_limits<float>::infinity())
+            {
+                worst = std::min(worst, static_cast<double>(it->second));
+                sum += it->second;
+                ++nbScores;
+            }
+        GaussianProcess model;
+        bool fitted = false;
+        if (nbScores)
+        {
+            for (it = this->_scores.begin(); it != itEnd; ++it)
+            {
+                this->_PointToInput(this->_points[it->first], input);
+                inputs.push_back(input);
+                outputs.push_back(it->second != -std::numeric_limits<float>::infinity() ? it->second : worst);
+            }
+            // constant liar: the pending points are expected to be average
+            std::map<unsigned int, unsigned int>::const_iterator pending = this->_pendingIds.begin();
+            std::map<unsigned int, unsigned int>::const_iterator pendingEnd = this->_pendingIds.end();
+            for (; pending != pendingEnd; ++pending)
+            {
+                this->_PointToInput(this->_points[pending->second], input);
+                inputs.push_back(input);
+                outputs.push_back(sum / nbScores);
+            }
+            fitted = model.Fit(inputs, outputs);
+        }
+        if (fitted)
+        {
+            // uniform candidates, and candidates around the best point
+            Point best;
+            for (it = this->_scores.begin(); it != itEnd; ++it)
+                if (it->second == this->_bestScore)
+                    best = this->_points[it->first];
+            std::normal_distribution<double> shift(0, 0.1);
+            Point candidate;
+            double bestImprovement = -1;
+            for (unsigned int c = 0; c < NbRandomCandidates + NbLocalCandidates; ++c)
+            {
+                if (c < NbRandomCandidates || best.empty())
+                    this->_DrawUniformPoint(candidate);
+                else
+                {
+                    candidate = best;
+                    for (unsigned int i = 0; i < candidate.size(); ++i)
+                    {
+                        double digit = candidate[i] + shift(this->_rng) * this->_floatParams[i].iterations;
+                        digit = std::max(0.0, std::min(digit + 0.5, this->_floatParams[i].iterations - 0.5));
+                        candidate[i] = static_cast<unsigned int>(digit);
+                    }
+                }
+                if (this->_HasPoint(candidate) || !this->_IsValid(candidate))
+                    continue;
+                double mean, deviation;
+                this->_PointToInput(candidate, input);
+                model.Predict(input, mean, deviation);
+                double improvement = GaussianProcess::ExpectedImprovement(mean, deviation, this->_bestScore);
+                if (improvement > bestImprovement)
+                {
+                    bestImprovement = improvement;
+                    point = candidate;
+                }
+            }
+        }
+        else
+            this->_logger.Log(CLASS "No model yet, testing a random point.");
+        if (!point.empty())
+            return this->_AddPoint(point);
+        // no model or no new candidate
+        for (unsigned int draws = 0; draws < NbRandomCandidates; ++draws)
+        {
+            this->_DrawUniformPoint(point);
+            if (this->_AddPoint(point))
+                return true;
+        }
+        this->_logger.Log(CLASS "No new point satisfying the constraints found.", ::Logger::Warning);
+        return false;
+    }
+}
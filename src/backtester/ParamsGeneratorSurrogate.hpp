@@ -0,0 +1,66 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_PARAMSGENERATORSURROGATE__
+#define __BACKTESTER_PARAMSGENERATORSURROGATE__
+
+#include <map>
+#include "ParamsGeneratorLhs.hpp"
+#include "GaussianProcess.hpp"
+
+namespace Backtester
+{
+    /*
+       Sequential model-based optimization: after surrogateInitial Latin hypercube points, a
+       Gaussian process is fitted to the scores and the point of the grid with the best expected
+       improvement is tested, until paramsBudget points are tested.
+       At most one point per thread is pending: the pending points are given the mean score while
+       fitting, so that the threads test different points.
+    */
+    class ParamsGeneratorSurrogate :
+        public ParamsGeneratorLhs
+    {
+        public:
+            explicit ParamsGeneratorSurrogate(Logger const& logger, Conf& conf);
+            virtual bool GenerateNextParams(StratParamsMap& params);
+            virtual void ReportFeedback(Report const& report);
+            virtual bool IsWaitingForReports() const;
+            virtual unsigned int GetNbTotalTasks() const;
+        private:
+            virtual unsigned int _GetNbInitialPoints() const;
+            void _PointToInput(Point const& point, GaussianProcess::Input& input) const;
+            bool _Propose();
+            unsigned int _nbGenerated;
+            std::map<unsigned int, unsigned int> _pendingIds; // point index by id
+            std::vector<std::pair<unsigned int, float> > _scores; // by point index
+            float _bestScore;
+    };
+}
+
+#endif
@@ -0,0 +1,122 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cmath>
+#include "Pruner.hpp"
+#include "TickGenerator.hpp"
+#include "Backtester.hpp"
+#include "Conf.hpp"
+#include "Logger.hpp"
+#include "Report.hpp"
+#include "ResultRanking.hpp"
+#include "core/History.hpp"
+#include "core/strategy/Strategy.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/Pruner] "
+
+namespace Backtester
+{
+    Pruner::Pruner(Logger const& logger, Conf const& conf, Core::History const& history, Backtester const& backtester) :
+        _logger(logger), _conf(conf), _history(history), _backtester(backtester), _prepared(false), _lotsWarned(false)
+    {
+    }
+
+    bool Pruner::IsEnabled() const
+    {
+        return this->_conf.pruneMinBalance || this->_conf.pruneMaxDrawdown || this->_conf.pruneTopK;
+    }
+
+    void Pruner::Prepare(Core::Strategy::Strategy const& strategy)
+    {
+        if (this->_prepared || !this->_conf.pruneTopK)
+            return;
+        this->_prepared = true;
+        std::vector<double> variations(this->_history.GetBars().size() + 1, 0);
+        TickGenerator tickGenerator(this->_history, this->_logger, this->_conf);
+        std::pair<float, float> tick;
+        Core::Bar bar;
+        float lastBid = 0;
+        bool first = true;
+        while (true)
+        {
+            unsigned int pos = tickGenerator.GetHistoryPos();
+            TickGenerator::GenerationResult tickGen = tickGenerator.GenerateNextTick(strategy, tick, bar);
+            if (tickGen == TickGenerator::NoMoreTicks)
+                break;
+            else if (tickGen == TickGenerator::Interruption)
+                continue;
+            if (!first && pos < variations.size())
+                variations[pos] += fabs(tick.second - lastBid); // ask moves like bid
+            lastBid = tick.second;
+            first = false;
+        }
+        this->_remainingPips.resize(variations.size());
+        double sum = 0;
+        for (unsigned int i = variations.size(); i > 0; --i)
+        {
+            sum += variations[i - 1];
+            this->_remainingPips[i - 1] = strategy.OffsetToPips(sum);
+        }
+    }
+
+    bool Pruner::Check(Report const& report, float balance, float peakBalance, float maxLots, unsigned int historyPos, std::string& reason)
+    {
+        if (this->_conf.pruneMinBalance && balance < this->_conf.deposit * this->_conf.pruneMinBalance / 100)
+        {
+            reason = "balance " + Tools::ToString(balance, 2) + " below " + Tools::ToString(this->_conf.pruneMinBalance, 2) + "% of the deposit";
+            return true;
+        }
+        if (this->_conf.pruneMaxDrawdown && peakBalance > 0 && (peakBalance - balance) / peakBalance * 100 > this->_conf.pruneMaxDrawdown)
+        {
+            reason = "drawdown above " + Tools::ToString(this->_conf.pruneMaxDrawdown, 2) + "%";
+            return true;
+        }
+        if (this->_conf.pruneTopK && this->_prepared && historyPos < this->_remainingPips.size())
+        {
+            if (maxLots > this->_conf.pruneMaxLots)
+            {
+                if (!this->_lotsWarned)
+                {
+                    this->_logger.Log(CLASS "Strategy opened " + Tools::ToString(maxLots, 2) + " lots, more than pruneMaxLots: no score bound for these tasks.", ::Logger::Warning);
+                    this->_lotsWarned = true;
+                }
+                return false;
+            }
+            float threshold = this->_backtester.GetScoreThreshold();
+            float bound = this->_backtester.GetResultRanking().UpperBound(report, this->_remainingPips[historyPos] * 10 * this->_conf.pruneMaxLots);
+            if (bound < threshold)
+            {
+                reason = "score bound " + Tools::ToString(bound, 2) + " below top " + Tools::ToString(this->_conf.pruneTopK) + " threshold " + Tools::ToString(threshold, 2);
+                return true;
+            }
+        }
+        return false;
+    }
+}
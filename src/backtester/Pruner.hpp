@@ -0,0 +1,91 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_PRUNER__
+#define __BACKTESTER_PRUNER__
+
+#include <boost/noncopyable.hpp>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+    class History;
+    namespace Strategy
+    {
+        class Strategy;
+    }
+}
+
+namespace Backtester
+{
+    class Conf;
+    class Logger;
+    class Backtester;
+    class Report;
+
+    /*
+       Decides, each time a trade closes, if a task can be stopped before the end of the history:
+        - balance below pruneMinBalance% of the deposit,
+        - drawdown of the balance above pruneMaxDrawdown% of its peak,
+        - score upper bound below the score of the K-th best report (K is pruneTopK).
+
+       The upper bound assumes at most pruneMaxLots lots per position: the remaining profit can not
+       exceed the total variation of the remaining ticks. It is disabled for a task opening more lots.
+    */
+    class Pruner :
+        private boost::noncopyable
+    {
+        public:
+            explicit Pruner(Logger const& logger, Conf const& conf, Core::History const& history, Backtester const& backtester);
+            bool IsEnabled() const;
+
+            /*
+               Computes the remaining tick variations once (ticks only depend on the history and the digits).
+            */
+            void Prepare(Core::Strategy::Strategy const& strategy);
+
+            /*
+               historyPos is the position of the bar of the last tick.
+               Returns true and sets reason if the task should stop.
+            */
+            bool Check(Report const& report, float balance, float peakBalance, float maxLots, unsigned int historyPos, std::string& reason);
+
+        private:
+            Logger const& _logger;
+            Conf const& _conf;
+            Core::History const& _history;
+            Backtester const& _backtester;
+            std::vector<float> _remainingPips; // total tick variation in pips from a bar to the end
+            bool _prepared;
+            bool _lotsWarned;
+    };
+}
+
+#endif
@@ -27,6 +27,7 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <iostream>
 #include "Report.hpp"
 #include "Logger.hpp"
 #include "tools/ToString.hpp"
@@ -37,7 +38,7 @@
 namespace Backtester
 {
     Report::Report(Logger const& logger) :
-        _logger(logger), _params(logger), _failed(false), _score(0)
+        _logger(logger), _params(logger), _failed(false), _pruned(false), _score(0)
     {
     }
 
@@ -60,6 +61,7 @@ namespace Backtester
     {
         this->_params.GetDataFrom(report.GetParams());
         this->_failed = report.HasFailed();
+        this->_pruned = report.IsPruned();
         this->_trades = report.GetTrades();
     }
 
@@ -83,6 +85,16 @@ namespace Backtester
         return this->_failed;
     }
 
+    void Report::SetPruned()
+    {
+        this->_pruned = true;
+    }
+
+    bool Report::IsPruned() const
+    {
+        return this->_pruned;
+    }
+
     void Report::AddTrade(Trade const& trade)
     {
         this->_trades.push_back(trade);
@@ -119,4 +131,45 @@ namespace Backtester
         }
         this->_logger.Log(CLASS "=== End trade report ===");
     }
+
+    void Report::Serialize(std::ostream& out) const
+    {
+        std::streamsize precision = out.precision(9); // enough to read back the same floats
+        out << (this->_failed ? 1 : this->_pruned ? 2 : 0) << " " << this->_trades.size(); // status
+        std::list<Trade>::const_iterator it = this->_trades.begin();
+        std::list<Trade>::const_iterator itEnd = this->_trades.end();
+        for (; it != itEnd; ++it)
+            out << " " << it->type
+                << " " << it->open
+                << " " << it->close
+                << " " << it->lots
+                << " " << it->sl
+                << " " << it->tp
+                << " " << it->pips
+                << " " << it->baseCurrencyProfit
+                << " " << it->counterCurrencyProfit;
+        out.precision(precision);
+    }
+
+    bool Report::Unserialize(std::istream& in)
+    {
+        int status;
+        unsigned int nbTrades;
+        if (!(in >> status >> nbTrades))
+            return false;
+        std::list<Trade> trades;
+        for (unsigned int i = 0; i < nbTrades; ++i)
+        {
+            Trade t;
+            int type;
+            if (!(in >> type >> t.open >> t.close >> t.lots >> t.sl >> t.tp >> t.pips >> t.baseCurrencyProfit >> t.counterCurrencyProfit))
+                return false;
+            t.type = static_cast<Core::Controller::Status>(type);
+            trades.push_back(t);
+        }
+        this->_failed = status == 1;
+        this->_pruned = status == 2;
+        this->_trades.swap(trades);
+        return true;
+    }
 }
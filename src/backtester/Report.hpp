@@ -32,6 +32,7 @@
 
 #include <boost/noncopyable.hpp>
 #include <list>
+#include <iosfwd>
 #include "StratParamsMap.hpp"
 #include "core/Controller.hpp"
 
@@ -63,15 +64,29 @@ namespace Backtester
             void DumpParams(bool oneLine = false) const;
             bool HasFailed() const;
             void SetFailed();
+
+            /*
+               Pruned reports were stopped before the end of the history: their trades are incomplete.
+            */
+            bool IsPruned() const;
+            void SetPruned();
             void AddTrade(Trade const& trade);
             std::list<Trade> const& GetTrades() const;
             void ShowTradeDetails(Conf const& conf);
             void SetScore(float score);
             float GetScore() const;
+
+            /*
+               Compact text form of the results (failure/pruned status and trades, not the parameters).
+               Unserialize() returns false on malformed input and leaves the report unmodified.
+            */
+            void Serialize(std::ostream& out) const;
+            bool Unserialize(std::istream& in);
         private:
             Logger const& _logger;
             StratParamsMap _params;
             bool _failed;
+            bool _pruned;
             std::list<Trade> _trades;
             float _score;
     };
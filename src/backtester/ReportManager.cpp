@@ -27,7 +27,11 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <limits>
+#include <iterator>
 #include "ReportManager.hpp"
+#include "MonteCarlo.hpp"
+#include "ResultExport.hpp"
 #include "Report.hpp"
 #include "Conf.hpp"
 #include "ResultRankingProfit.hpp"
@@ -39,6 +43,8 @@ namespace Backtester
 {
     namespace
     {
+        unsigned int const MaxShownReports = 10;
+
         bool CompareReports(Report* r1, Report* r2)
         {
             return r1->GetScore() < r2->GetScore();
@@ -60,10 +66,10 @@ namespace Backtester
 
     ResultRanking* ReportManager::_ResultRankingFactory(std::string const& name) const
     {
-        if (name == "profit")
-            return new ResultRankingProfit(this->_logger, this->_conf);
-        else
-            this->Log(CLASS "Result ranking \"" + name + "\" not found, using default \"profit\".", ::Logger::Warning);
+        ResultRankingFactory factory = ResultRankingRegistry::GetInstance().Find(name);
+        if (factory)
+            return factory(this->_logger, this->_conf);
+        this->Log(CLASS "Result ranking \"" + name + "\" not found (available: " + ResultRankingRegistry::GetInstance().GetNamesString() + "), using default \"profit\".", ::Logger::Warning);
         return new ResultRankingProfit(this->_logger, this->_conf);
     }
 
@@ -83,16 +89,48 @@ namespace Backtester
                 delete *it;
             this->_failedReports.clear();
         }
+        {
+            std::list<Report*>::iterator it = this->_prunedReports.begin();
+            std::list<Report*>::iterator itEnd = this->_prunedReports.end();
+            for (; it != itEnd; ++it)
+                delete *it;
+            this->_prunedReports.clear();
+        }
+        this->_topScores.clear();
     }
 
-    void ReportManager::AddReport(Report const& report)
+    Report const& ReportManager::AddReport(Report const& report)
     {
         Report* r = new Report(this->_logger);
         r->CopyDataFrom(report);
         if (r->HasFailed())
             this->_failedReports.push_back(r);
+        else if (r->IsPruned())
+            this->_prunedReports.push_back(r);
         else
+        {
+            r->SetScore(this->_resultRanking->Rank(*r));
             this->_reports.push_back(r);
+            if (this->_conf.pruneTopK)
+            {
+                this->_topScores.insert(r->GetScore());
+                if (this->_topScores.size() > this->_conf.pruneTopK)
+                    this->_topScores.erase(this->_topScores.begin());
+            }
+        }
+        return *r;
+    }
+
+    float ReportManager::GetScoreThreshold() const
+    {
+        if (!this->_conf.pruneTopK || this->_topScores.size() < this->_conf.pruneTopK)
+            return -std::numeric_limits<float>::infinity();
+        return *this->_topScores.begin();
+    }
+
+    ResultRanking const& ReportManager::GetResultRanking() const
+    {
+        return *this->_resultRanking;
     }
 
     void ReportManager::ShowTradeDetails()
@@ -107,18 +145,23 @@ namespace Backtester
     {
         this->Log(CLASS + Tools::ToString(this->_reports.size()) + " successful report" + (this->_reports.size() > 1 ? "s" : "") + " collected.");
         this->Log(CLASS "Reports marked as failed: " + Tools::ToString(this->_failedReports.size()) + ".", this->_failedReports.size() ? ::Logger::Warning : ::Logger::Info);
+        if (this->_prunedReports.size())
+            this->Log(CLASS "Reports pruned: " + Tools::ToString(this->_prunedReports.size()) + ".");
+        this->_reports.sort(CompareReports);
+        if (!this->_conf.resultsFile.empty() || !this->_conf.heatmaps.empty())
         {
-            std::list<Report*>::iterator it = this->_reports.begin();
-            std::list<Report*>::iterator itEnd = this->_reports.end();
-            for (; it != itEnd; ++it)
-                (*it)->SetScore(this->_resultRanking->Rank(**it));
+            ResultExport resultExport(this->_logger, this->_conf);
+            resultExport.Write(this->_reports);
         }
-        this->_reports.sort(CompareReports);
         if (this->_reports.size() > 1)
         {
-            this->Log(CLASS "Sorted reports (result ranking \"" + this->_resultRanking->GetName() + "\"):");
+            // the others are in resultsFile
+            unsigned int nbShown = this->_reports.size() < MaxShownReports ? this->_reports.size() : MaxShownReports;
+            this->Log(CLASS "Sorted reports (result ranking \"" + this->_resultRanking->GetName() + "\"" +
+                    (nbShown < this->_reports.size() ? ", " + Tools::ToString(nbShown) + " best" : std::string("")) + "):");
             std::list<Report*>::iterator it = this->_reports.begin();
             std::list<Report*>::iterator itEnd = this->_reports.end();
+            std::advance(it, this->_reports.size() - nbShown);
             for (; it != itEnd; ++it)
                 this->Log(CLASS + (*it)->GetParams().GetFloatParamsString() + " Score " + Tools::ToString((*it)->GetScore()));
             this->_ShowReport(**this->_reports.rbegin());
@@ -127,6 +170,15 @@ namespace Backtester
             this->_ShowReport(**this->_reports.begin());
         else
             this->Log(CLASS "No results to show.", ::Logger::Warning);
+        if (this->_conf.monteCarloRuns)
+        {
+            // best reports first
+            MonteCarlo monteCarlo(this->_logger, this->_conf);
+            std::list<Report*>::reverse_iterator it = this->_reports.rbegin();
+            std::list<Report*>::reverse_iterator itEnd = this->_reports.rend();
+            for (unsigned int i = 0; it != itEnd && i < this->_conf.monteCarloTopK; ++it, ++i)
+                monteCarlo.Run(**it);
+        }
     }
 
     void ReportManager::_ShowReport(Report& report) const
@@ -32,6 +32,7 @@
 
 #include <boost/noncopyable.hpp>
 #include <list>
+#include <set>
 #include <string>
 #include "Logger.hpp"
 
@@ -47,7 +48,17 @@ namespace Backtester
         public:
             explicit ReportManager(Logger const& logger, Conf const& conf);
             ~ReportManager();
-            void AddReport(Report const& report);
+
+            /*
+               Returns the stored copy, scored if the report is successful.
+            */
+            Report const& AddReport(Report const& report);
+
+            /*
+               Score of the K-th best report (K is pruneTopK), -infinity while there are less than K reports.
+            */
+            float GetScoreThreshold() const;
+            ResultRanking const& GetResultRanking() const;
             void Reset();
             void Run();
             void Log(std::string const& msg, ::Logger::MessageType type = ::Logger::Info) const;
@@ -58,6 +69,8 @@ namespace Backtester
             Logger const& _logger;
             std::list<Report*> _reports;
             std::list<Report*> _failedReports;
+            std::list<Report*> _prunedReports;
+            std::multiset<float> _topScores;
             Conf const& _conf;
             ResultRanking* _resultRanking;
     };
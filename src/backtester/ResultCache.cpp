@@ -0,0 +1,153 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <sstream>
+#include "ResultCache.hpp"
+#include "Logger.hpp"
+#include "Report.hpp"
+#include "StratParamsMap.hpp"
+#include "Conf.hpp"
+#include "core/History.hpp"
+#include "tools/Hash.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/ResultCache] "
+
+/*
+   File format (one entry per line, append-only):
+     <key in hexadecimal> <serialized report>
+*/
+
+namespace Backtester
+{
+    ResultCache::ResultCache(Logger const& logger, Conf const& conf, Core::History const& history) :
+        _logger(logger), _conf(conf), _nbHits(0), _nbStored(0)
+    {
+        // everything but the parameters is hashed once
+        Tools::Hash h;
+        h.Add(this->_conf.GetTradesHash()).Add(history.GetFingerprint());
+        this->_runKey = h.GetValue();
+    }
+
+    bool ResultCache::Open()
+    {
+        unsigned int ignored = 0;
+        {
+            std::ifstream f(this->_conf.resultCacheFile.c_str());
+            std::string line;
+            while (std::getline(f, line))
+            {
+                std::istringstream ss(line);
+                boost::uint64_t key;
+                std::string report;
+                if (!(ss >> std::hex >> key >> std::dec))
+                {
+                    if (!line.empty())
+                        ++ignored;
+                    continue;
+                }
+                std::getline(ss, report);
+                Report dummy(this->_logger);
+                std::istringstream rs(report);
+                if (dummy.Unserialize(rs))
+                    this->_results[key] = report;
+                else
+                    ++ignored;
+            }
+        }
+        if (ignored)
+            this->_logger.Log(CLASS "Ignored " + Tools::ToString(ignored) + " invalid line" + (ignored > 1 ? "s" : "") + " in result cache.", ::Logger::Warning);
+        this->_file.open(this->_conf.resultCacheFile.c_str(), std::ios::out | std::ios::app);
+        if (!this->_file.good())
+        {
+            this->_logger.Log(CLASS "Failed to open result cache \"" + this->_conf.resultCacheFile + "\".", ::Logger::Error);
+            return false;
+        }
+        this->_file << std::endl; // the last line may have been cut
+        this->_logger.Log(CLASS "Using result cache \"" + this->_conf.resultCacheFile + "\" (" + Tools::ToString(this->_results.size()) + " results).");
+        return true;
+    }
+
+    boost::uint64_t ResultCache::_Key(StratParamsMap const& params) const
+    {
+        Tools::Hash h;
+        h.Add(this->_runKey);
+        // ranges after the first bar start with warm-up bars and include a warm-up marker, whole history keys hash no range
+        if (params.GetHistoryBegin())
+            h.Add(std::string("warm-up"));
+        if (params.GetHistoryBegin() || params.GetHistoryEnd())
+            h.Add(params.GetHistoryBegin()).Add(params.GetHistoryEnd());
+        {
+            std::map<std::string, float>::const_iterator it = params.GetFloatMap().begin();
+            std::map<std::string, float>::const_iterator itEnd = params.GetFloatMap().end();
+            for (; it != itEnd; ++it)
+                h.Add(it->first).Add(it->second);
+        }
+        {
+            std::map<std::string, std::string>::const_iterator it = params.GetStringMap().begin();
+            std::map<std::string, std::string>::const_iterator itEnd = params.GetStringMap().end();
+            for (; it != itEnd; ++it)
+                h.Add(it->first).Add(it->second);
+        }
+        return h.GetValue();
+    }
+
+    bool ResultCache::Find(StratParamsMap const& params, Report& report)
+    {
+        std::map<boost::uint64_t, std::string>::const_iterator it = this->_results.find(this->_Key(params));
+        if (it == this->_results.end())
+            return false;
+        std::istringstream ss(it->second);
+        if (!report.Unserialize(ss))
+            return false;
+        ++this->_nbHits;
+        return true;
+    }
+
+    void ResultCache::Store(Report const& report)
+    {
+        std::ostringstream ss;
+        ss << " ";
+        report.Serialize(ss);
+        boost::uint64_t key = this->_Key(report.GetParams());
+        if (!this->_results.insert(std::make_pair(key, ss.str())).second)
+            return;
+        this->_file << std::hex << key << std::dec << ss.str() << "\n";
+        ++this->_nbStored;
+    }
+
+    void ResultCache::Flush()
+    {
+        this->_file.flush();
+        if (!this->_file.good())
+            this->_logger.Log(CLASS "Failed to write to result cache \"" + this->_conf.resultCacheFile + "\".", ::Logger::Warning);
+        this->_logger.Log(CLASS "Result cache: " + Tools::ToString(this->_nbHits) + " hit" + (this->_nbHits > 1 ? "s" : "") + ", " +
+                Tools::ToString(this->_nbStored) + " new result" + (this->_nbStored > 1 ? "s" : "") + ".");
+    }
+}
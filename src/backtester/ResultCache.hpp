@@ -0,0 +1,86 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_RESULTCACHE__
+#define __BACKTESTER_RESULTCACHE__
+
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <fstream>
+#include <map>
+#include <string>
+
+namespace Core
+{
+    class History;
+}
+
+namespace Backtester
+{
+    class Logger;
+    class Conf;
+    class Report;
+    class StratParamsMap;
+
+    /*
+       Persistent results of already tested parameters, shared between runs.
+       Results are keyed by a hash of the strategy name, the parameters, the history data and the configuration
+       fields that change the trades (pair, period, digits, spread, minimal price offset and tick generation).
+    */
+    class ResultCache :
+        private boost::noncopyable
+    {
+        public:
+            explicit ResultCache(Logger const& logger, Conf const& conf, Core::History const& history);
+
+            /*
+               Loads the cache file and opens it for appending.
+            */
+            bool Open();
+
+            /*
+               Copies the cached results of params to report (parameters are not modified).
+            */
+            bool Find(StratParamsMap const& params, Report& report);
+
+            void Store(Report const& report);
+            void Flush();
+        private:
+            boost::uint64_t _Key(StratParamsMap const& params) const;
+            Logger const& _logger;
+            Conf const& _conf;
+            std::ofstream _file;
+            std::map<boost::uint64_t, std::string> _results;
+            boost::uint64_t _runKey;
+            unsigned int _nbHits;
+            unsigned int _nbStored;
+    };
+}
+
+#endif
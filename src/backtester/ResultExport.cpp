@@ -0,0 +1,229 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <fstream>
+#include <limits>
+#include <map>
+#include <boost/cstdint.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include "ResultExport.hpp"
+#include "Report.hpp"
+#include "Logger.hpp"
+#include "Conf.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/ResultExport] "
+
+namespace Backtester
+{
+    ResultExport::ResultExport(Logger const& logger, Conf const& conf) :
+        _logger(logger), _conf(conf), _firstMetric(0)
+    {
+    }
+
+    void ResultExport::Write(std::list<Report*> const& reports)
+    {
+        if (reports.empty())
+            return;
+        this->_reports.assign(reports.begin(), reports.end());
+        this->_names.clear();
+        std::map<std::string, float> const& params = this->_reports.front()->GetParams().GetFloatMap();
+        std::map<std::string, float>::const_iterator it = params.begin();
+        std::map<std::string, float>::const_iterator itEnd = params.end();
+        for (; it != itEnd; ++it)
+            this->_names.push_back(it->first);
+        this->_firstMetric = this->_names.size();
+        this->_names.push_back("score");
+        this->_names.push_back("profit");
+        this->_names.push_back("trades");
+        this->_names.push_back("winRate");
+        this->_names.push_back("maxDrawdown");
+        this->_ids.resize(this->_reports.size());
+        this->_columns.assign(this->_names.size(), std::vector<float>(this->_reports.size()));
+
+        unsigned int nbRows = this->_reports.size();
+        unsigned int nbThreads = boost::thread::hardware_concurrency();
+        if (nbThreads < 1)
+            nbThreads = 1;
+        if (nbThreads > nbRows)
+            nbThreads = nbRows;
+        boost::thread_group threads;
+        for (unsigned int i = 0; i < nbThreads; ++i)
+            threads.create_thread(boost::bind(&ResultExport::_ComputeRows, this, nbRows * i / nbThreads, nbRows * (i + 1) / nbThreads));
+        threads.join_all();
+
+        if (!this->_conf.resultsFile.empty())
+            this->_WriteColumns();
+        std::string pairs = this->_conf.heatmaps;
+        while (!pairs.empty())
+        {
+            std::string pair = pairs.substr(0, pairs.find(','));
+            pairs.erase(0, pair.size() + 1);
+            std::string::size_type colon = pair.find(':');
+            if (colon == std::string::npos)
+            {
+                this->_logger.Log(CLASS "Invalid heatmap \"" + pair + "\", expecting \"param1:param2\".", ::Logger::Warning);
+                continue;
+            }
+            this->_WriteHeatmap(pair.substr(0, colon), pair.substr(colon + 1));
+        }
+    }
+
+    void ResultExport::_ComputeRows(unsigned int begin, unsigned int end)
+    {
+        for (unsigned int row = begin; row < end; ++row)
+        {
+            Report const& report = *this->_reports[row];
+            this->_ids[row] = report.GetParams().GetId();
+            std::map<std::string, float> const& params = report.GetParams().GetFloatMap();
+            for (unsigned int column = 0; column < this->_firstMetric; ++column)
+            {
+                std::map<std::string, float>::const_iterator param = params.find(this->_names[column]);
+                this->_columns[column][row] = param != params.end() ? param->second : std::numeric_limits<float>::quiet_NaN();
+            }
+            float balance = this->_conf.deposit;
+            float peak = balance;
+            float maxDrawdown = 0;
+            unsigned int profitTrades = 0;
+            std::list<Report::Trade>::const_iterator it = report.GetTrades().begin();
+            std::list<Report::Trade>::const_iterator itEnd = report.GetTrades().end();
+            for (; it != itEnd; ++it)
+            {
+                balance += it->counterCurrencyProfit;
+                if (it->counterCurrencyProfit > 0)
+                    ++profitTrades;
+                if (balance > peak)
+                    peak = balance;
+                else if (peak > 0 && (peak - balance) / peak > maxDrawdown)
+                    maxDrawdown = (peak - balance) / peak;
+            }
+            unsigned int nbTrades = report.GetTrades().size();
+            this->_columns[this->_firstMetric][row] = report.GetScore();
+            this->_columns[this->_firstMetric + 1][row] = balance - this->_conf.deposit;
+            this->_columns[this->_firstMetric + 2][row] = nbTrades;
+            this->_columns[this->_firstMetric + 3][row] = nbTrades ? profitTrades * 100.0f / nbTrades : 0;
+            this->_columns[this->_firstMetric + 4][row] = maxDrawdown * 100;
+        }
+    }
+
+    void ResultExport::_WriteColumns() const
+    {
+        std::ofstream f(this->_conf.resultsFile.c_str(), std::ios::binary);
+        boost::uint32_t header[3] = { 2, static_cast<boost::uint32_t>(this->_columns.size() + 1), static_cast<boost::uint32_t>(this->_reports.size()) };
+        f.write("OTRESULT", 8);
+        f.write(reinterpret_cast<char const*>(header), sizeof(header));
+        boost::uint32_t idSize = 2;
+        f.write(reinterpret_cast<char const*>(&idSize), sizeof(idSize));
+        f.write("id", idSize);
+        std::vector<std::string>::const_iterator name = this->_names.begin();
+        std::vector<std::string>::const_iterator nameEnd = this->_names.end();
+        for (; name != nameEnd; ++name)
+        {
+            boost::uint32_t size = name->size();
+            f.write(reinterpret_cast<char const*>(&size), sizeof(size));
+            f.write(name->data(), size);
+        }
+        f.write(reinterpret_cast<char const*>(&this->_ids.front()), this->_ids.size() * sizeof(boost::uint32_t));
+        std::vector<std::vector<float> >::const_iterator column = this->_columns.begin();
+        std::vector<std::vector<float> >::const_iterator columnEnd = this->_columns.end();
+        for (; column != columnEnd; ++column)
+            f.write(reinterpret_cast<char const*>(&column->front()), column->size() * sizeof(float));
+        if (f.good())
+            this->_logger.Log(CLASS "Wrote " + Tools::ToString(this->_reports.size()) + " results to \"" + this->_conf.resultsFile + "\".");
+        else
+            this->_logger.Log(CLASS "Failed to write results file \"" + this->_conf.resultsFile + "\".", ::Logger::Warning);
+    }
+
+    int ResultExport::_GetColumn(std::string const& name) const
+    {
+        for (unsigned int i = 0; i < this->_firstMetric; ++i)
+            if (this->_names[i] == name)
+                return i;
+        return -1;
+    }
+
+    void ResultExport::_WriteHeatmap(std::string const& x, std::string const& y) const
+    {
+        int xColumn = this->_GetColumn(x);
+        int yColumn = this->_GetColumn(y);
+        if (xColumn < 0 || yColumn < 0)
+        {
+            this->_logger.Log(CLASS "Unknown parameter in heatmap \"" + x + ":" + y + "\".", ::Logger::Warning);
+            return;
+        }
+        // best score of each cell
+        std::map<float, unsigned int> xValues;
+        std::map<float, unsigned int> yValues;
+        for (unsigned int row = 0; row < this->_reports.size(); ++row)
+        {
+            xValues[this->_columns[xColumn][row]] = 0;
+            yValues[this->_columns[yColumn][row]] = 0;
+        }
+        unsigned int i = 0;
+        std::map<float, unsigned int>::iterator it = xValues.begin();
+        std::map<float, unsigned int>::iterator itEnd = xValues.end();
+        for (; it != itEnd; ++it)
+            it->second = i++;
+        i = 0;
+        for (it = yValues.begin(), itEnd = yValues.end(); it != itEnd; ++it)
+            it->second = i++;
+        std::vector<float> cells(xValues.size() * yValues.size(), -std::numeric_limits<float>::infinity());
+        for (unsigned int row = 0; row < this->_reports.size(); ++row)
+        {
+            float& cell = cells[yValues[this->_columns[yColumn][row]] * xValues.size() + xValues[this->_columns[xColumn][row]]];
+            if (this->_columns[this->_firstMetric][row] > cell)
+                cell = this->_columns[this->_firstMetric][row];
+        }
+
+        std::string file = this->_conf.heatmapPrefix + "-" + x + "-" + y + ".dat";
+        std::ofstream f(file.c_str());
+        f << "# best score by " << x << " (columns) and " << y << " (rows)" << std::endl;
+        f << "# plot \"" << file << "\" nonuniform matrix with image" << std::endl;
+        f << xValues.size();
+        for (it = xValues.begin(), itEnd = xValues.end(); it != itEnd; ++it)
+            f << " " << it->first;
+        f << std::endl;
+        i = 0;
+        for (it = yValues.begin(), itEnd = yValues.end(); it != itEnd; ++it)
+        {
+            f << it->first;
+            for (unsigned int j = 0; j < xValues.size(); ++j, ++i)
+                if (cells[i] == -std::numeric_limits<float>::infinity())
+                    f << " NaN";
+                else
+                    f << " " << cells[i];
+            f << std::endl;
+        }
+        if (f.good())
+            this->_logger.Log(CLASS "Wrote heatmap \"" + file + "\" (" + Tools::ToString(xValues.size()) + "x" + Tools::ToString(yValues.size()) + ").");
+        else
+            this->_logger.Log(CLASS "Failed to write heatmap \"" + file + "\".", ::Logger::Warning);
+    }
+}
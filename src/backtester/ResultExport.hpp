@@ -0,0 +1,78 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_RESULTEXPORT__
+#define __BACKTESTER_RESULTEXPORT__
+
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace Backtester
+{
+    class Logger;
+    class Conf;
+    class Report;
+
+    /*
+       Exports the successful reports of an optimization, one row per report:
+         - resultsFile: columnar binary file, all in host byte order:
+             "OTRESULT", uint32 version (2), uint32 number of columns, uint32 number of rows,
+             the name of each column (uint32 length and characters), then each column (uint32 values
+             for the id, float32 values for the others).
+           The columns are the id, the float parameters, score, profit, trades, winRate (%) and
+           maxDrawdown (% of the peak balance).
+         - heatmaps: for each "param1:param2" pair, heatmapPrefix-param1-param2.dat holds the best
+           score for each pair of values, as a gnuplot nonuniform matrix.
+       The rows are computed in parallel on all the cores.
+    */
+    class ResultExport :
+        private boost::noncopyable
+    {
+        public:
+            explicit ResultExport(Logger const& logger, Conf const& conf);
+            void Write(std::list<Report*> const& reports);
+        private:
+            void _ComputeRows(unsigned int begin, unsigned int end);
+            void _WriteColumns() const;
+            void _WriteHeatmap(std::string const& x, std::string const& y) const;
+            int _GetColumn(std::string const& name) const;
+            Logger const& _logger;
+            Conf const& _conf;
+            std::vector<Report const*> _reports;
+            std::vector<std::string> _names; // without the id
+            std::vector<boost::uint32_t> _ids;
+            std::vector<std::vector<float> > _columns;
+            unsigned int _firstMetric; // column of the score
+    };
+}
+
+#endif
@@ -27,6 +27,7 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <limits>
 #include "ResultRanking.hpp"
 
 namespace Backtester
@@ -40,6 +41,11 @@ namespace Backtester
     {
     }
 
+    float ResultRanking::UpperBound(Report const&, float) const
+    {
+        return std::numeric_limits<float>::infinity();
+    }
+
     std::string const& ResultRanking::GetName() const
     {
         return this->_name;
@@ -32,6 +32,7 @@
 
 #include <boost/noncopyable.hpp>
 #include <string>
+#include "tools/Registry.hpp"
 
 namespace Backtester
 {
@@ -46,6 +47,13 @@ namespace Backtester
             ResultRanking(std::string const& name, Logger const& logger, Conf const& conf);
             virtual ~ResultRanking();
             virtual float Rank(Report const& report) const = 0;
+
+            /*
+               Highest score the report could reach if its trades made at most maxFurtherProfit
+               more (in counter currency) until the end of the history.
+               Infinity if the ranking can not tell (never pruned).
+            */
+            virtual float UpperBound(Report const& report, float maxFurtherProfit) const;
             std::string const& GetName() const;
         protected:
             Logger const& _logger;
@@ -53,6 +61,13 @@ namespace Backtester
         private:
             std::string _name;
     };
+
+    typedef ResultRanking* (*ResultRankingFactory)(Logger const& logger, Conf const& conf);
+
+    /*
+       Result rankings, registered by name like the strategies (see Core::StrategyRegistry).
+    */
+    typedef Tools::Registry<ResultRankingFactory> ResultRankingRegistry;
 }
 
 #endif
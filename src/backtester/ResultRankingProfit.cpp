@@ -36,6 +36,16 @@
 
 namespace Backtester
 {
+    namespace
+    {
+        ResultRanking* Create(Logger const& logger, Conf const& conf)
+        {
+            return new ResultRankingProfit(logger, conf);
+        }
+
+        ResultRankingRegistry::Registrar registrar("profit", &Create);
+    }
+
     ResultRankingProfit::ResultRankingProfit(Logger const& logger, Conf const& conf) :
         ResultRanking("profit", logger, conf)
     {
@@ -51,4 +61,9 @@ namespace Backtester
         //this->_logger.Log(CLASS + report.GetParams().GetFloatParamsString() + " score " + Tools::ToString(profit));
         return profit;
     }
+
+    float ResultRankingProfit::UpperBound(Report const& report, float maxFurtherProfit) const
+    {
+        return this->Rank(report) + maxFurtherProfit;
+    }
 }
@@ -40,6 +40,7 @@ namespace Backtester
         public:
             ResultRankingProfit(Logger const& logger, Conf const& conf);
             virtual float Rank(Report const& report) const;
+            virtual float UpperBound(Report const& report, float maxFurtherProfit) const;
     };
 }
 
@@ -27,6 +27,7 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <iostream>
 #include "StratParamsMap.hpp"
 #include "tools/ToString.hpp"
 
@@ -35,7 +36,7 @@
 namespace Backtester
 {
     StratParamsMap::StratParamsMap(Logger::Logger const& logger) :
-        StratParams(logger), _id(0)
+        StratParams(logger), _valuesWithoutSlot(false), _id(0), _historyBegin(0), _historyEnd(0)
     {
     }
 
@@ -43,7 +44,10 @@ namespace Backtester
     {
         this->_floatValues = params.GetFloatMap();
         this->_stringValues = params.GetStringMap();
+        this->_valuesWithoutSlot = true;
         this->_id = params.GetId();
+        this->_historyBegin = params.GetHistoryBegin();
+        this->_historyEnd = params.GetHistoryEnd();
     }
 
     float StratParamsMap::GetFloat(std::string const& name, float defaultValue)
@@ -71,18 +75,69 @@ namespace Backtester
     void StratParamsMap::SetFloat(std::string const& name, float value)
     {
         this->_floatValues[name] = value;
+        this->_valuesWithoutSlot = true;
     }
 
     void StratParamsMap::SetString(std::string const& name, std::string value)
     {
         this->_stringValues[name] = value;
+        this->_valuesWithoutSlot = true;
+    }
+
+    void StratParamsMap::SetFloat(std::string const& name, unsigned int slot, float value)
+    {
+        this->_floatValues[name] = value;
+        if (slot < this->_floatSlotsSet.size())
+        {
+            this->SetFloatSlot(slot, value);
+            this->_floatSlotsSet[slot] = true;
+        }
+    }
+
+    void StratParamsMap::SetString(std::string const& name, unsigned int slot, std::string const& value)
+    {
+        this->_stringValues[name] = value;
+        if (slot < this->_stringSlotsSet.size())
+        {
+            this->SetStringSlot(slot, value);
+            this->_stringSlotsSet[slot] = true;
+        }
+    }
+
+    void StratParamsMap::UpdateSlots()
+    {
+        if (!this->_valuesWithoutSlot && this->_floatSlotsSet.size() == this->GetNbFloatSlots() && this->_stringSlotsSet.size() == this->GetNbStringSlots())
+        {
+            for (unsigned int slot = 0; slot < this->GetNbFloatSlots(); ++slot)
+                if (!this->_floatSlotsSet[slot])
+                    this->SetFloatSlot(slot, this->GetFloatSlotDefault(slot));
+            for (unsigned int slot = 0; slot < this->GetNbStringSlots(); ++slot)
+                if (!this->_stringSlotsSet[slot])
+                    this->SetStringSlot(slot, this->GetStringSlotDefault(slot));
+            return;
+        }
+        for (unsigned int slot = 0; slot < this->GetNbFloatSlots(); ++slot)
+        {
+            std::map<std::string, float>::const_iterator it = this->_floatValues.find(this->GetFloatSlotName(slot));
+            this->SetFloatSlot(slot, it != this->_floatValues.end() ? it->second : this->GetFloatSlotDefault(slot));
+        }
+        for (unsigned int slot = 0; slot < this->GetNbStringSlots(); ++slot)
+        {
+            std::map<std::string, std::string>::const_iterator it = this->_stringValues.find(this->GetStringSlotName(slot));
+            this->SetStringSlot(slot, it != this->_stringValues.end() ? it->second : this->GetStringSlotDefault(slot));
+        }
     }
 
     void StratParamsMap::Reset()
     {
         this->_id = 0;
+        this->_historyBegin = 0;
+        this->_historyEnd = 0;
         this->_floatValues.clear();
         this->_stringValues.clear();
+        this->_floatSlotsSet.assign(this->GetNbFloatSlots(), false);
+        this->_stringSlotsSet.assign(this->GetNbStringSlots(), false);
+        this->_valuesWithoutSlot = false;
     }
 
     void StratParamsMap::SetId(unsigned int id)
@@ -90,6 +145,22 @@ namespace Backtester
         this->_id = id;
     }
 
+    void StratParamsMap::SetHistoryRange(unsigned int begin, unsigned int end)
+    {
+        this->_historyBegin = begin;
+        this->_historyEnd = end;
+    }
+
+    unsigned int StratParamsMap::GetHistoryBegin() const
+    {
+        return this->_historyBegin;
+    }
+
+    unsigned int StratParamsMap::GetHistoryEnd() const
+    {
+        return this->_historyEnd;
+    }
+
     unsigned int StratParamsMap::GetId() const
     {
         return this->_id;
@@ -157,4 +228,67 @@ namespace Backtester
             }
         }
     }
+
+    void StratParamsMap::Serialize(std::ostream& out) const
+    {
+        std::streamsize precision = out.precision(9); // enough to read back the same floats
+        out << this->_id << " " << this->_historyBegin << " " << this->_historyEnd << " " << this->_floatValues.size();
+        {
+            std::map<std::string, float>::const_iterator it = this->_floatValues.begin();
+            std::map<std::string, float>::const_iterator itEnd = this->_floatValues.end();
+            for (; it != itEnd; ++it)
+                out << " " << it->first << " " << it->second;
+        }
+        out << " " << this->_stringValues.size();
+        {
+            // values may contain spaces: length prefixed
+            std::map<std::string, std::string>::const_iterator it = this->_stringValues.begin();
+            std::map<std::string, std::string>::const_iterator itEnd = this->_stringValues.end();
+            for (; it != itEnd; ++it)
+                out << " " << it->first << " " << it->second.size() << ":" << it->second;
+        }
+        out.precision(precision);
+    }
+
+    bool StratParamsMap::Unserialize(std::istream& in)
+    {
+        unsigned int id;
+        unsigned int historyBegin;
+        unsigned int historyEnd;
+        unsigned int nbFloats;
+        if (!(in >> id >> historyBegin >> historyEnd >> nbFloats))
+            return false;
+        std::map<std::string, float> floatValues;
+        for (unsigned int i = 0; i < nbFloats; ++i)
+        {
+            std::string name;
+            float value;
+            if (!(in >> name >> value))
+                return false;
+            floatValues[name] = value;
+        }
+        unsigned int nbStrings;
+        if (!(in >> nbStrings))
+            return false;
+        std::map<std::string, std::string> stringValues;
+        for (unsigned int i = 0; i < nbStrings; ++i)
+        {
+            std::string name;
+            unsigned int size;
+            char colon;
+            if (!(in >> name >> size) || !in.get(colon) || colon != ':')
+                return false;
+            std::string value(size, ' ');
+            if (size && !in.read(&value[0], size))
+                return false;
+            stringValues[name] = value;
+        }
+        this->_id = id;
+        this->_historyBegin = historyBegin;
+        this->_historyEnd = historyEnd;
+        this->_floatValues.swap(floatValues);
+        this->_stringValues.swap(stringValues);
+        this->_valuesWithoutSlot = true;
+        return true;
+    }
 }
@@ -31,6 +31,8 @@
 #define __BACKTESTER_STRATPARAMSMAP__
 
 #include <map>
+#include <vector>
+#include <iosfwd>
 #include "core/StratParams.hpp"
 
 namespace Backtester
@@ -43,19 +45,52 @@ namespace Backtester
             void GetDataFrom(StratParamsMap const& params);
             virtual float GetFloat(std::string const& name, float defaultValue);
             virtual std::string GetString(std::string const& name, std::string const& defaultValue);
+
+            /*
+               Silent: a missing parameter was already reported when its slot was declared.
+               Without lookup when every value was set with its slot since the last Reset(): the other slots take
+               their default value.
+            */
+            virtual void UpdateSlots();
             void SetFloat(std::string const& name, float value);
             void SetString(std::string const& name, std::string value);
+
+            /*
+               Also writes the value in its slot (see ParamsGeneratorGrid::_WriteParams()). A slot of GetNbFloatSlots()
+               (or GetNbStringSlots()) or more is a parameter the strategy does not declare: only its value is kept.
+            */
+            void SetFloat(std::string const& name, unsigned int slot, float value);
+            void SetString(std::string const& name, unsigned int slot, std::string const& value);
             std::map<std::string, float> const& GetFloatMap() const;
             std::map<std::string, std::string> const& GetStringMap() const;
             void Reset();
             unsigned int GetId() const;
             void SetId(unsigned int id);
+
+            /*
+               Part of the history to test, in 1 minute bars (end excluded, 0 for the end of the history).
+            */
+            void SetHistoryRange(unsigned int begin, unsigned int end);
+            unsigned int GetHistoryBegin() const;
+            unsigned int GetHistoryEnd() const;
             void Dump(bool oneLine = false) const;
             std::string GetFloatParamsString() const;
+
+            /*
+               Compact text form of the id, history range, floats and strings (on one line).
+               Unserialize() returns false on malformed input.
+            */
+            void Serialize(std::ostream& out) const;
+            bool Unserialize(std::istream& in);
         private:
             std::map<std::string, float> _floatValues;
             std::map<std::string, std::string> _stringValues;
+            std::vector<bool> _floatSlotsSet; // since the last Reset()
+            std::vector<bool> _stringSlotsSet;
+            bool _valuesWithoutSlot; // values set by name only: UpdateSlots() looks them up
             unsigned int _id;
+            unsigned int _historyBegin;
+            unsigned int _historyEnd;
     };
 }
 
@@ -31,15 +31,17 @@
 #include "TickGenerator.hpp"
 #include "Logger.hpp"
 #include "tools/ToString.hpp"
-#include "StratParamsMap.hpp"
+#include "tools/Allocations.hpp"
 #include "core/StrategyInstantiator.hpp"
-#include "core/Controller.hpp"
+#include "core/BasicController.hpp"
 #include "core/strategy/Strategy.hpp"
+#include "core/signal/MaCross.hpp"
 #include "core/actor/Actor.hpp"
-#include "Feedback.hpp"
+#include "core/actor/DoNothing.hpp"
 #include "Conf.hpp"
 #include "Report.hpp"
 #include "PlotGenerator.hpp"
+#include "Pruner.hpp"
 
 #define CLASS "[Backtester/Task] "
 
@@ -48,17 +50,20 @@ namespace Backtester
     Task::Task(TickGenerator& tickGenerator,
             Logger const& logger,
             Conf const& conf,
-            StratParamsMap& stratParams,
-            Report& report) :
+            Core::StrategyInstantiator& strategyInstantiator,
+            Report& report,
+            Pruner* pruner /* = 0 */) :
         _tickGenerator(tickGenerator),
         _logger(logger),
         _conf(conf),
-        _stratParams(stratParams),
+        _strategyInstantiator(strategyInstantiator),
         _report(report),
-        _plotGenerator(0)
+        _plotGenerator(0),
+        _pruner(pruner),
+        _historyPos(0),
+        _tradeBegin(0),
+        _pruned(false)
     {
-        this->_feedback = new Feedback();
-        this->_strategyInstantiator = new Core::StrategyInstantiator(this->_logger, *this->_feedback, this->_stratParams);
         if (!this->_conf.optimizationMode && this->_conf.plotOutput)
             this->_plotGenerator = new PlotGenerator(this->_logger, this->_conf);
     }
@@ -66,8 +71,6 @@ namespace Backtester
     Task::~Task()
     {
         delete this->_plotGenerator;
-        delete this->_strategyInstantiator;
-        delete this->_feedback;
     }
 
     void Task::_ResetState()
@@ -82,29 +85,50 @@ namespace Backtester
     bool Task::Run()
     {
         this->_state.balance = this->_conf.deposit;
+        this->_state.peakBalance = this->_state.balance;
+        this->_state.maxLots = 0;
         this->_ResetState();
-        this->_strategyInstantiator->Instantiate(this->_conf.strategy, this->_conf.pair, this->_conf.period, this->_conf.digits);
-        if (!this->_strategyInstantiator->StrategyInstantiated())
+        if (!this->_strategyInstantiator.Recycle(this->_conf.strategy, this->_conf.pair, this->_conf.period, this->_conf.digits))
         {
             this->_logger.Log(CLASS "Failed to instantiate strategy \"" + this->_conf.strategy + "\".", ::Logger::Error);
             return false;
         }
-        this->_strategyInstantiator->GetStrategy()->GetActor().SetLogStartStop(false);
-        Core::Controller* controller = new Core::Controller(*this->_strategyInstantiator->GetStrategy());
-        this->_Run(*controller);
-        delete controller;
-        this->_strategyInstantiator->Destroy();
+        this->_strategyInstantiator.GetStrategy()->GetActor().SetLogStartStop(false);
+        if (this->_pruner)
+            this->_pruner->Prepare(*this->_strategyInstantiator.GetStrategy());
+        Core::Strategy::Strategy& strategy = *this->_strategyInstantiator.GetStrategy();
+        this->_tradeBegin = this->_tickGenerator.WarmUp(strategy.GetSignal().GetMinBars());
+        // specialized tick loops first, virtual calls for the other strategies
+        if (!this->_RunAs<Core::Signal::MaCross, Core::Actor::DoNothing>(strategy))
+            this->_RunAs<Core::Signal::Signal, Core::Actor::Actor>(strategy);
         return true;
     }
 
-    void Task::_Run(Core::Controller& controller)
+    template <class SignalType, class ActorType>
+    bool Task::_RunAs(Core::Strategy::Strategy& strategy)
+    {
+        if (!dynamic_cast<SignalType*>(&strategy.GetSignal()) || !dynamic_cast<ActorType*>(&strategy.GetActor()))
+            return false;
+        Core::BasicController<SignalType, ActorType, false> controller(strategy); // the feedback of the backtester is never needed
+        this->_Run(controller);
+        return true;
+    }
+
+    template <class ControllerType>
+    void Task::_Run(ControllerType& controller)
     {
         std::pair<float, float> tick; // tick.first -> ask, tick.second -> bid
         Core::Bar bar;
         TickGenerator::GenerationResult tickGen;
-        while (true)
+#ifdef COUNT_ALLOCATIONS
+        unsigned long nbAllocations = Tools::GetNbAllocations();
+        unsigned long nbTicks = 0;
+        unsigned long nbTrades = 0;
+#endif
+        while (!this->_pruned)
         {
-            tickGen = this->_tickGenerator.GenerateNextTick(*this->_strategyInstantiator->GetStrategy(), tick, bar);
+            this->_historyPos = this->_tickGenerator.GetHistoryPos();
+            tickGen = this->_tickGenerator.GenerateNextTick(*this->_strategyInstantiator.GetStrategy(), tick, bar);
             if (tickGen == TickGenerator::Interruption)
             {
                 controller.Interrupt();
@@ -114,8 +138,16 @@ namespace Backtester
             else if (tickGen == TickGenerator::NoMoreTicks)
                 break;
             this->_PreTick(bar, tick);
+#ifdef COUNT_ALLOCATIONS
+            ++nbTicks;
+#endif
             controller.ProcessTick(bar, tick.first, tick.second, this->_state.status, tickGen == TickGenerator::NewBarTick);
-            if (this->_PostTick(bar, tick, controller.GetLastOutput()))
+            // the warm-up bars before the history range only feed the signal
+            if (this->_historyPos >= this->_tradeBegin && this->_PostTick(bar, tick, controller.GetLastOutput()))
+            {
+#ifdef COUNT_ALLOCATIONS
+                ++nbTrades;
+#endif
                 controller.ProcessTrade(this->_state.status,
                         this->_state.open,
                         this->_state.lots,
@@ -123,9 +155,14 @@ namespace Backtester
                         this->_state.tp,
                         tick.first,
                         tick.second);
+            }
             if (this->_plotGenerator && bar.time % 60 == 0)
                 this->_AddPlotData(bar.time, tick);
         }
+#ifdef COUNT_ALLOCATIONS
+        // the tick loop itself should not allocate, only the trades (report entries, logs)
+        this->_logger.Log(CLASS "Tick loop: " + Tools::ToString(Tools::GetNbAllocations() - nbAllocations) + " allocations for " + Tools::ToString(nbTicks) + " ticks and " + Tools::ToString(nbTrades) + " trades.");
+#endif
         if (this->_plotGenerator)
             this->_plotGenerator->WriteToDisk();
     }
@@ -135,13 +172,13 @@ namespace Backtester
         float equity;
         equity = this->_state.balance;
         if (this->_state.status == Core::Controller::StatusBuy)
-            equity += this->_strategyInstantiator->GetStrategy()->OffsetToPips(tick.second - this->_state.open) * 10 * this->_state.lots;
+            equity += this->_strategyInstantiator.GetStrategy()->OffsetToPips(tick.second - this->_state.open) * 10 * this->_state.lots;
         else if (this->_state.status == Core::Controller::StatusSell)
-            equity += this->_strategyInstantiator->GetStrategy()->OffsetToPips(this->_state.open - tick.first) * 10 * this->_state.lots;
+            equity += this->_strategyInstantiator.GetStrategy()->OffsetToPips(this->_state.open - tick.first) * 10 * this->_state.lots;
         this->_plotGenerator->AddData(time, this->_state.balance, equity);
     }
 
-    void Task::_ClosePosition(Core::Bar const& bar, float price, std::string const& reason)
+    void Task::_ClosePosition(Core::Bar const& bar, float price, char const* reason)
     {
         Report::Trade t;
         t.type = this->_state.status;
@@ -149,9 +186,9 @@ namespace Backtester
         t.lots = this->_state.lots;
         t.close = price;
         if (this->_state.status == Core::Controller::StatusBuy)
-            t.pips = this->_strategyInstantiator->GetStrategy()->OffsetToPips(t.close - t.open);
+            t.pips = this->_strategyInstantiator.GetStrategy()->OffsetToPips(t.close - t.open);
         else
-            t.pips = this->_strategyInstantiator->GetStrategy()->OffsetToPips(t.open - t.close);
+            t.pips = this->_strategyInstantiator.GetStrategy()->OffsetToPips(t.open - t.close);
         t.counterCurrencyProfit = t.pips * 10 * t.lots;
         t.baseCurrencyProfit = t.counterCurrencyProfit * (1 / t.close);
         t.sl = this->_state.sl;
@@ -164,10 +201,27 @@ namespace Backtester
                     this->_PriceString(price) + ": " +
                     reason + " (" + (t.counterCurrencyProfit > 0 ? "profit" : t.counterCurrencyProfit == 0 ? "even" : "loss") + ").");
         this->_state.balance += t.counterCurrencyProfit;
+        if (this->_state.balance > this->_state.peakBalance)
+            this->_state.peakBalance = this->_state.balance;
+        if (t.lots > this->_state.maxLots)
+            this->_state.maxLots = t.lots;
         this->_ResetState();
+        if (this->_pruner)
+            this->_CheckPruning(bar);
+    }
+
+    void Task::_CheckPruning(Core::Bar const& bar)
+    {
+        std::string reason;
+        if (this->_pruned || !this->_pruner->Check(this->_report, this->_state.balance, this->_state.peakBalance, this->_state.maxLots, this->_historyPos, reason))
+            return;
+        this->_pruned = true;
+        this->_report.SetPruned();
+        if (this->_conf.showTradeActions)
+            this->_logger.Log(CLASS "Pruned at " + bar.TimeToString() + ": " + reason + ".");
     }
 
-    void Task::_ClosePosition(Core::Bar const& bar, std::pair<float, float> const& tick, std::string const& reason)
+    void Task::_ClosePosition(Core::Bar const& bar, std::pair<float, float> const& tick, char const* reason)
     {
         if (this->_state.status == Core::Controller::StatusBuy)
             this->_ClosePosition(bar, tick.second, reason);
@@ -203,7 +257,7 @@ namespace Backtester
     {
         if (o.order == Core::Controller::OrderNothing)
             return false;
-        Core::Strategy::Strategy& s = *this->_strategyInstantiator->GetStrategy();
+        Core::Strategy::Strategy& s = *this->_strategyInstantiator.GetStrategy();
         float sl = s.RoundPrice(o.sl);
         float tp = s.RoundPrice(o.tp);
         if (this->_state.status == Core::Controller::StatusNothing) // backtester not trading
@@ -295,7 +349,7 @@ namespace Backtester
     // returns true if there is a problem
     bool Task::_CheckPriceRange(std::pair<float, float> const& tick, float price) const
     {
-        float minPriceOffset = this->_conf.minPriceOffset * this->_strategyInstantiator->GetStrategy()->GetPipPrice();
+        float minPriceOffset = this->_conf.minPriceOffset * this->_strategyInstantiator.GetStrategy()->GetPipPrice();
         float rangeHigher = tick.first + minPriceOffset; // ask + X
         float rangeLower = tick.second - minPriceOffset; // bid - X
         return price <= rangeHigher && price >= rangeLower;
@@ -303,12 +357,12 @@ namespace Backtester
 
     std::string Task::_PriceString(std::pair<float, float> const& tick) const
     {
-        return "[ask " + Tools::ToString(tick.first, this->_strategyInstantiator->GetStrategy()->GetDigits()) +
-            ", bid " + Tools::ToString(tick.second, this->_strategyInstantiator->GetStrategy()->GetDigits()) + "]";
+        return "[ask " + Tools::ToString(tick.first, this->_strategyInstantiator.GetStrategy()->GetDigits()) +
+            ", bid " + Tools::ToString(tick.second, this->_strategyInstantiator.GetStrategy()->GetDigits()) + "]";
     }
 
     std::string Task::_PriceString(float price) const
     {
-        return Tools::ToString(price, this->_strategyInstantiator->GetStrategy()->GetDigits());
+        return Tools::ToString(price, this->_strategyInstantiator.GetStrategy()->GetDigits());
     }
 }
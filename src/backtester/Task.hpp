@@ -37,27 +37,34 @@
 namespace Core
 {
     class StrategyInstantiator;
+    namespace Strategy
+    {
+        class Strategy;
+    }
 }
 
 namespace Backtester
 {
     class TickGenerator;
     class Logger;
-    class Feedback;
-    class StratParamsMap;
     class Conf;
     class Report;
     class PlotGenerator;
+    class Pruner;
 
     class Task :
         private boost::noncopyable
     {
         public:
+            /*
+               The strategy is (re)instantiated by strategyInstantiator when running and kept for the next task.
+            */
             explicit Task(TickGenerator& tickGenerator,
                     Logger const& logger,
                     Conf const& conf,
-                    StratParamsMap& stratParams,
-                    Report& report);
+                    Core::StrategyInstantiator& strategyInstantiator,
+                    Report& report,
+                    Pruner* pruner = 0);
             ~Task();
             bool Run();
         private:
@@ -69,10 +76,20 @@ namespace Backtester
                 float sl;
                 float tp;
                 float balance;
+                float peakBalance;
+                float maxLots;
             };
-            void _Run(Core::Controller& controller);
-            void _ClosePosition(Core::Bar const& bar, std::pair<float, float> const& tick, std::string const& reason);
-            void _ClosePosition(Core::Bar const& bar, float price, std::string const& reason);
+
+            /*
+               Runs the ticks with a Core::BasicController on the concrete signal and actor types of the strategy.
+               false -> The signal or the actor of the strategy is not of these types.
+            */
+            template <class SignalType, class ActorType>
+                bool _RunAs(Core::Strategy::Strategy& strategy);
+            template <class ControllerType>
+                void _Run(ControllerType& controller);
+            void _ClosePosition(Core::Bar const& bar, std::pair<float, float> const& tick, char const* reason);
+            void _ClosePosition(Core::Bar const& bar, float price, char const* reason);
             void _Interrupt(Core::Bar const& bar, std::pair<float, float> const& tick);
             void _PreTick(Core::Bar const& bar, std::pair<float, float> const& tick);
             bool _PostTick(Core::Bar const& bar, std::pair<float, float> const& tick, Core::Controller::Output const& output);
@@ -81,15 +98,18 @@ namespace Backtester
             std::string _PriceString(float price) const;
             bool _CheckPriceRange(std::pair<float, float> const& tick, float price) const;
             void _AddPlotData(time_t, std::pair<float, float> const& tick);
+            void _CheckPruning(Core::Bar const& bar);
             TickGenerator& _tickGenerator;
             Logger const& _logger;
             Conf const& _conf;
-            StratParamsMap& _stratParams;
-            Feedback* _feedback;
-            Core::StrategyInstantiator* _strategyInstantiator;
+            Core::StrategyInstantiator& _strategyInstantiator;
             State _state;
             Report& _report;
             PlotGenerator* _plotGenerator;
+            Pruner* _pruner;
+            unsigned int _historyPos;
+            unsigned int _tradeBegin; // first position of the history range, after the warm-up bars
+            bool _pruned;
     };
 }
 
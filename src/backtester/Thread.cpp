@@ -34,6 +34,8 @@
 #include "Report.hpp"
 #include "ReportManager.hpp"
 #include "Backtester.hpp"
+#include "Feedback.hpp"
+#include "core/StrategyInstantiator.hpp"
 #include "tools/ToString.hpp"
 
 #define CLASS "[Backtester/Thread] "
@@ -41,7 +43,8 @@
 namespace Backtester
 {
     Thread::Thread(unsigned int id, Conf conf, Core::History& clonableHistory, Backtester& backtester) :
-        _id(id), _logger(id), _conf(conf), _history(_logger), _running(false), _thread(0), _backtester(backtester)
+        _id(id), _logger(id), _conf(conf), _history(_logger), _running(false), _thread(0), _backtester(backtester),
+        _pruner(_logger, _conf, _history, backtester)
     {
         this->_history.CopyDataFrom(clonableHistory);
     }
@@ -87,22 +90,24 @@ namespace Backtester
     void Thread::_Run()
     {
         StratParamsMap params(this->_logger);
+        Feedback feedback;
+        Core::StrategyInstantiator strategyInstantiator(this->_logger, feedback, params); // the strategy is reset for each test instead of being instantiated again
         while (this->_backtester.GetNewParamsFromThread(params))
         {
             Report report(this->_logger);
-            this->_Test(params, report);
+            this->_Test(params, strategyInstantiator, report);
             this->_backtester.SubmitReportFromThread(report);
         }
     }
 
-    void Thread::_Test(StratParamsMap& stratParams, Report& report)
+    void Thread::_Test(StratParamsMap& stratParams, Core::StrategyInstantiator& strategyInstantiator, Report& report)
     {
         this->_logger.Log(CLASS "=== Begin test for generated parameters " + Tools::ToString(stratParams.GetId()) + " ===");
-        TickGenerator tickGenerator(this->_history, this->_logger, this->_conf);
+        TickGenerator tickGenerator(this->_history, this->_logger, this->_conf, stratParams.GetHistoryBegin(), stratParams.GetHistoryEnd());
         report.CopyParamsFrom(stratParams);
-        Task test(tickGenerator, this->_logger, this->_conf, stratParams, report);
+        Task test(tickGenerator, this->_logger, this->_conf, strategyInstantiator, report, this->_pruner.IsEnabled() ? &this->_pruner : 0);
         if (test.Run())
-            this->_logger.Log(CLASS "=== Test end (success) for generated parameters " + Tools::ToString(stratParams.GetId()) + " ===");
+            this->_logger.Log(CLASS "=== Test end (" + std::string(report.IsPruned() ? "pruned" : "success") + ") for generated parameters " + Tools::ToString(stratParams.GetId()) + " ===");
         else
         {
             this->_logger.Log(CLASS "=== Test end (failure) for generated parameters " + Tools::ToString(stratParams.GetId()) + " ===", ::Logger::Error);
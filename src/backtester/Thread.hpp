@@ -36,6 +36,12 @@
 #include "Conf.hpp"
 #include "core/History.hpp"
 #include "Logger.hpp"
+#include "Pruner.hpp"
+
+namespace Core
+{
+    class StrategyInstantiator;
+}
 
 namespace Backtester
 {
@@ -55,7 +61,7 @@ namespace Backtester
             void Join();
         private:
             void _Run();
-            void _Test(StratParamsMap& stratParams, Report& report);
+            void _Test(StratParamsMap& stratParams, Core::StrategyInstantiator& strategyInstantiator, Report& report);
             unsigned int _id;
             Logger _logger;
             Conf _conf;
@@ -63,6 +69,7 @@ namespace Backtester
             bool _running;
             boost::thread* _thread;
             Backtester& _backtester;
+            Pruner _pruner;
     };
 }
 
@@ -38,16 +38,19 @@
 
 namespace Backtester
 {
-    TickGenerator::TickGenerator(Core::History const& history, Logger const& logger, Conf const& conf) :
-        _history(history), _conf(conf), _logger(logger), _barPos(0)
+    TickGenerator::TickGenerator(Core::History const& history, Logger const& logger, Conf const& conf, unsigned int historyBegin /* = 0 */, unsigned int historyEnd /* = 0 */) :
+        _history(history), _conf(conf), _logger(logger), _barPos(0), _nbTicks(0), _nextTick(0)
     {
-        this->_historyPos = this->_history.GetFirstBarPosOfPeriod(this->_conf.period);
+        this->_historyPos = this->_history.GetFirstBarPosOfPeriod(this->_conf.period, historyBegin);
+        this->_historyEnd = historyEnd ? historyEnd : this->_history.GetBars().size();
     }
 
     TickGenerator::GenerationResult TickGenerator::GenerateNextTick(Core::Strategy::Strategy const& strategy, std::pair<float, float>& tick, Core::Bar& bar)
     {
-        if (this->_tickBuffer.empty())
+        if (this->_nextTick == this->_nbTicks)
         {
+            if (this->_historyPos >= this->_historyEnd)
+                return NoMoreTicks;
             Core::Bar minuteBar;
             Core::History::FetchType fetch = this->_history.FetchBar(minuteBar, this->_historyPos, 1);
             if (fetch == Core::History::FetchError)
@@ -58,13 +61,14 @@ namespace Backtester
                 return Interruption;
             }
             this->_currentBar.time = minuteBar.time;
+            this->_nbTicks = 0;
+            this->_nextTick = 0;
             if (this->_conf.fewerTicks)
                 this->_GenerateFewerTicks(strategy, minuteBar);
             else
                 this->_GenerateTicks(strategy, minuteBar);
         }
-        float value = this->_tickBuffer.front();
-        this->_tickBuffer.pop();
+        float value = this->_ticks[this->_nextTick++];
         GenerationResult ret;
         if (this->_currentBar.valid)
         {
@@ -88,11 +92,24 @@ namespace Backtester
         ++this->_currentBar.time; // adds 1 second so that the next tick is not a multiple of 60
         tick.first = value + strategy.PipsToOffset(this->_conf.spread);
         tick.second = value;
-        if (this->_tickBuffer.empty())
+        if (this->_nextTick == this->_nbTicks)
             this->_NextBar();
         return ret;
     }
 
+    unsigned int TickGenerator::GetHistoryPos() const
+    {
+        return this->_historyPos;
+    }
+
+    unsigned int TickGenerator::WarmUp(unsigned int nbBars)
+    {
+        unsigned int begin = this->_historyPos;
+        unsigned int warmUp = nbBars * this->_conf.period;
+        this->_historyPos = this->_history.GetFirstBarPosOfPeriod(this->_conf.period, begin > warmUp ? begin - warmUp : 0);
+        return begin;
+    }
+
     void TickGenerator::_NextBar()
     {
         ++this->_historyPos;
@@ -104,112 +121,117 @@ namespace Backtester
         }
     }
 
+    void TickGenerator::_PushTick(float value)
+    {
+        this->_ticks[this->_nbTicks++] = value;
+    }
+
     void TickGenerator::_GenerateFewerTicks(Core::Strategy::Strategy const&, Core::Bar const& bar)
     {
-        this->_tickBuffer.push(bar.o);
+        this->_PushTick(bar.o);
         if (bar.o == bar.c)
         {
             if (bar.h == bar.l)
                 return;
             else if (bar.l == bar.o)
-                this->_tickBuffer.push(bar.h);
+                this->_PushTick(bar.h);
             else if (bar.h == bar.o)
-                this->_tickBuffer.push(bar.l);
+                this->_PushTick(bar.l);
             else
             {
-                this->_tickBuffer.push(bar.l);
-                this->_tickBuffer.push(bar.h);
+                this->_PushTick(bar.l);
+                this->_PushTick(bar.h);
             }
         }
         else if (bar.l == bar.c && bar.h != bar.o)
-            this->_tickBuffer.push(bar.h);
+            this->_PushTick(bar.h);
         else if (bar.h == bar.c && bar.l != bar.o)
-            this->_tickBuffer.push(bar.l);
+            this->_PushTick(bar.l);
         else if (bar.o == bar.l)
-            this->_tickBuffer.push(bar.h);
+            this->_PushTick(bar.h);
         else if (bar.o == bar.h)
-            this->_tickBuffer.push(bar.l);
+            this->_PushTick(bar.l);
         else
         {
             if (bar.c > bar.o)
             {
-                this->_tickBuffer.push(bar.l);
-                this->_tickBuffer.push(bar.h);
+                this->_PushTick(bar.l);
+                this->_PushTick(bar.h);
             }
             else
             {
-                this->_tickBuffer.push(bar.h);
-                this->_tickBuffer.push(bar.l);
+                this->_PushTick(bar.h);
+                this->_PushTick(bar.l);
             }
         }
-        this->_tickBuffer.push(bar.c);
+        this->_PushTick(bar.c);
     }
 
     void TickGenerator::_GenerateTicks(Core::Strategy::Strategy const& strategy, Core::Bar const& bar)
     {
-        this->_tickBuffer.push(bar.o);
+        this->_PushTick(bar.o);
         if (bar.o == bar.c)
         {
             if (bar.h == bar.l) // l | h ~
                 return;
             else if (bar.l == bar.o) // l |- h ~
-                this->_tickBuffer.push(bar.h);
+                this->_PushTick(bar.h);
             else if (bar.h == bar.o) // l -| h ~
-                this->_tickBuffer.push(bar.l);
+                this->_PushTick(bar.l);
             else // l -|- h ~
             {
-                this->_tickBuffer.push(bar.l);
-                this->_tickBuffer.push(bar.h);
+                this->_PushTick(bar.l);
+                this->_PushTick(bar.h);
             }
         }
         else if (bar.l == bar.c)
         {
             if (bar.h == bar.o) // l | | h <
-                this->_tickBuffer.push(strategy.FloorPrice(bar.c + 0.5 * (bar.o - bar.c)));
+                this->_PushTick(strategy.FloorPrice(bar.c + 0.5 * (bar.o - bar.c)));
             else // l | |- h <
-                this->_tickBuffer.push(bar.h);
+                this->_PushTick(bar.h);
         }
         else if (bar.h == bar.c)
         {
             if (bar.l == bar.o) // l | | h >
-                this->_tickBuffer.push(strategy.CeilPrice(bar.o + 0.5 * (bar.c - bar.o)));
+                this->_PushTick(strategy.CeilPrice(bar.o + 0.5 * (bar.c - bar.o)));
             else // l -| | h >
-                this->_tickBuffer.push(bar.l);
+                this->_PushTick(bar.l);
         }
         else if (bar.o == bar.l) // l | |- h >
-            this->_tickBuffer.push(bar.h);
+            this->_PushTick(bar.h);
         else if (bar.o == bar.h) // l -| | h <
-            this->_tickBuffer.push(bar.l);
+            this->_PushTick(bar.l);
         else
         {
             float unit = fabs(bar.c - bar.o) > strategy.GetPriceUnit() ? strategy.GetPriceUnit() : 0;
             if (bar.c > bar.o) // l -| |- h >
             {
-                this->_tickBuffer.push(strategy.CeilPrice(bar.l + 0.25 * (bar.o - bar.l)));
-                this->_tickBuffer.push(strategy.CeilPrice(bar.l + 0.5 * (bar.o - bar.l)));
-                this->_tickBuffer.push(bar.l);
-                this->_tickBuffer.push(strategy.CeilPrice(bar.l + 0.33 * (bar.h - bar.l)));
-                this->_tickBuffer.push(strategy.CeilPrice(bar.l + 0.33 * (bar.h - bar.l) - unit));
-                this->_tickBuffer.push(strategy.CeilPrice(bar.l + 0.66 * (bar.h - bar.l)));
-                this->_tickBuffer.push(strategy.CeilPrice(bar.l + 0.66 * (bar.h - bar.l) - unit));
-                this->_tickBuffer.push(bar.h);
-                this->_tickBuffer.push(strategy.CeilPrice(bar.h - 0.75 * (bar.h - bar.c)));
-                this->_tickBuffer.push(strategy.CeilPrice(bar.h - 0.5 * (bar.h - bar.c)));
+                this->_PushTick(strategy.CeilPrice(bar.l + 0.25 * (bar.o - bar.l)));
+                this->_PushTick(strategy.CeilPrice(bar.l + 0.5 * (bar.o - bar.l)));
+                this->_PushTick(bar.l);
+                this->_PushTick(strategy.CeilPrice(bar.l + 0.33 * (bar.h - bar.l)));
+                this->_PushTick(strategy.CeilPrice(bar.l + 0.33 * (bar.h - bar.l) - unit));
+                this->_PushTick(strategy.CeilPrice(bar.l + 0.66 * (bar.h - bar.l)));
+                this->_PushTick(strategy.CeilPrice(bar.l + 0.66 * (bar.h - bar.l) - unit));
+                this->_PushTick(bar.h);
+                this->_PushTick(strategy.CeilPrice(bar.h - 0.75 * (bar.h - bar.c)));
+                this->_PushTick(strategy.CeilPrice(bar.h - 0.5 * (bar.h - bar.c)));
             }
             else // l -| |- h <
             {
-                this->_tickBuffer.push(strategy.FloorPrice(bar.h - 0.25 * (bar.h - bar.o)));
-                this->_tickBuffer.push(strategy.FloorPrice(bar.h - 0.5 * (bar.h - bar.o)));
-                this->_tickBuffer.push(bar.h);
-                this->_tickBuffer.push(strategy.FloorPrice(bar.l + 0.66 * (bar.h - bar.l)));
-                this->_tickBuffer.push(strategy.FloorPrice(bar.l + 0.66 * (bar.h - bar.l) + unit));
-                this->_tickBuffer.push(strategy.FloorPrice(bar.l + 0.33 * (bar.h - bar.l)));
-                this->_tickBuffer.push(strategy.FloorPrice(bar.l + 0.33 * (bar.h - bar.l) + unit));
-                this->_tickBuffer.push(bar.l);
-                this->_tickBuffer.push(strategy.FloorPrice(bar.l + 0.75 * (bar.c - bar.l)));
-                this->_tickBuffer.push(strategy.FloorPrice(bar.l + 0.5 * (bar.c - bar.l)));
+                this->_PushTick(strategy.FloorPrice(bar.h - 0.25 * (bar.h - bar.o)));
+                this->_PushTick(strategy.FloorPrice(bar.h - 0.5 * (bar.h - bar.o)));
+                this->_PushTick(bar.h);
+                this->_PushTick(strategy.FloorPrice(bar.l + 0.66 * (bar.h - bar.l)));
+                this->_PushTick(strategy.FloorPrice(bar.l + 0.66 * (bar.h - bar.l) + unit));
+                this->_PushTick(strategy.FloorPrice(bar.l + 0.33 * (bar.h - bar.l)));
+                this->_PushTick(strategy.FloorPrice(bar.l + 0.33 * (bar.h - bar.l) + unit));
+                this->_PushTick(bar.l);
+                this->_PushTick(strategy.FloorPrice(bar.l + 0.75 * (bar.c - bar.l)));
+                this->_PushTick(strategy.FloorPrice(bar.l + 0.5 * (bar.c - bar.l)));
             }
         }
-        this->_tickBuffer.push(bar.c);
+        this->_PushTick(bar.c);
     }
 }
@@ -32,7 +32,6 @@
 
 #include <boost/noncopyable.hpp>
 #include <utility>
-#include <queue>
 #include "core/Bar.hpp"
 
 namespace Core
@@ -60,7 +59,11 @@ namespace Backtester
                 Interruption,
                 NoMoreTicks,
             };
-            explicit TickGenerator(Core::History const& history, Logger const& logger, Conf const& conf);
+            /*
+               Ticks are generated from the bars between historyBegin and historyEnd (in 1 minute bars,
+               end excluded, 0 for the end of the history).
+            */
+            explicit TickGenerator(Core::History const& history, Logger const& logger, Conf const& conf, unsigned int historyBegin = 0, unsigned int historyEnd = 0);
 
             /*
                tick.first -> ask, tick.second -> bid
@@ -72,17 +75,37 @@ namespace Backtester
             */
             GenerationResult GenerateNextTick(Core::Strategy::Strategy const& strategy, std::pair<float, float>& tick, Core::Bar& bar);
 
+            /*
+               Position in 1 minute bars of the history bar of the next tick.
+            */
+            unsigned int GetHistoryPos() const;
+
+            /*
+               Starts up to nbBars bars (of the strategy period) before historyBegin, as far as the history goes,
+               so that the strategy has its minimal number of bars when the range begins.
+               Must be called before the first tick. Returns the position of the first bar of the range.
+            */
+            unsigned int WarmUp(unsigned int nbBars);
+
         private:
+            enum
+            {
+                MaxTicksPerBar = 12, // generated from a 1 minute bar by _GenerateTicks()
+            };
             void _NextBar();
+            void _PushTick(float value);
             void _GenerateTicks(Core::Strategy::Strategy const& strategy, Core::Bar const& bar);
             void _GenerateFewerTicks(Core::Strategy::Strategy const& strategy, Core::Bar const& bar);
             Core::History const& _history;
             Conf const& _conf;
             Logger const& _logger;
             unsigned int _historyPos;
+            unsigned int _historyEnd;
             unsigned int _barPos;
             Core::Bar _currentBar;
-            std::queue<float> _tickBuffer;
+            float _ticks[MaxTicksPerBar];
+            unsigned int _nbTicks;
+            unsigned int _nextTick;
     };
 }
 
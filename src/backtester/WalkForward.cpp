@@ -0,0 +1,260 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "WalkForward.hpp"
+#include "Logger.hpp"
+#include "Conf.hpp"
+#include "ParamsGenerator.hpp"
+#include "Report.hpp"
+#include "ReportManager.hpp"
+#include "ResultRanking.hpp"
+#include "core/History.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/WalkForward] "
+
+namespace Backtester
+{
+    WalkForward::WalkForward(Logger const& logger, Conf const& conf, Core::History const& history, ParamsGenerator& paramsGenerator, ResultRanking const& resultRanking) :
+        _logger(logger), _conf(conf), _history(history), _paramsGenerator(paramsGenerator), _resultRanking(resultRanking),
+        _currentParams(logger), _nextWindow(0), _generatorFinished(false)
+    {
+    }
+
+    WalkForward::~WalkForward()
+    {
+        std::vector<Window>::iterator it = this->_windows.begin();
+        std::vector<Window>::iterator itEnd = this->_windows.end();
+        for (; it != itEnd; ++it)
+        {
+            delete it->best;
+            delete it->outOfSample;
+        }
+        std::map<unsigned int, InSample>::iterator inSample = this->_inSamples.begin();
+        std::map<unsigned int, InSample>::iterator inSampleEnd = this->_inSamples.end();
+        for (; inSample != inSampleEnd; ++inSample)
+            delete inSample->second.report;
+    }
+
+    bool WalkForward::Initialize()
+    {
+        // the history has one bar per minute
+        unsigned int inSample = this->_conf.walkForwardInSample * 24 * 60;
+        unsigned int outOfSample = this->_conf.walkForwardOutOfSample * 24 * 60;
+        unsigned int size = this->_history.GetBars().size();
+        for (unsigned int begin = 0; begin + inSample + outOfSample <= size; begin += outOfSample)
+        {
+            Window w;
+            w.inSampleBegin = begin;
+            w.outOfSampleBegin = begin + inSample;
+            w.outOfSampleEnd = begin + inSample + outOfSample;
+            w.nbPendingReports = 0;
+            w.best = 0;
+            w.bestScore = 0;
+            w.outOfSampleGenerated = false;
+            w.outOfSample = 0;
+            this->_windows.push_back(w);
+        }
+        if (this->_windows.empty())
+        {
+            this->_logger.Log(CLASS "History too short for one window of " + Tools::ToString(this->_conf.walkForwardInSample) + " + " +
+                    Tools::ToString(this->_conf.walkForwardOutOfSample) + " days.", ::Logger::Error);
+            return false;
+        }
+        this->_logger.Log(CLASS + Tools::ToString(this->_windows.size()) + " walk-forward window" + (this->_windows.size() > 1 ? "s" : "") + " (" +
+                Tools::ToString(this->_conf.walkForwardInSample) + " days in-sample, " + Tools::ToString(this->_conf.walkForwardOutOfSample) + " days out-of-sample).");
+        this->_nextWindow = this->_windows.size(); // fetch parameters on first call
+        return true;
+    }
+
+    WalkForward::JobKey WalkForward::_GetJobKey(StratParamsMap const& params) const
+    {
+        return JobKey(params.GetId(), std::make_pair(params.GetHistoryBegin(), params.GetHistoryEnd()));
+    }
+
+    bool WalkForward::GenerateNextParams(StratParamsMap& params)
+    {
+        // out-of-sample tests as soon as all the in-sample reports of a window are in
+        if (this->_generatorFinished)
+            for (unsigned int i = 0; i < this->_windows.size(); ++i)
+            {
+                Window& w = this->_windows[i];
+                if (w.outOfSampleGenerated || w.nbPendingReports)
+                    continue;
+                w.outOfSampleGenerated = true;
+                if (!w.best)
+                {
+                    this->_logger.Log(CLASS "No successful in-sample result for window " + Tools::ToString(i + 1) + ".", ::Logger::Warning);
+                    continue;
+                }
+                params.GetDataFrom(w.best->GetParams());
+                params.SetHistoryRange(w.outOfSampleBegin, w.outOfSampleEnd);
+                Job job = { i, true };
+                this->_jobs.insert(std::make_pair(this->_GetJobKey(params), job));
+                ++w.nbPendingReports;
+                return true;
+            }
+
+        // in-sample tests: each generated parameters on every window
+        if (this->_generatorFinished)
+            return false;
+        if (this->_nextWindow >= this->_windows.size())
+        {
+            this->_currentParams.Reset();
+            if (!this->_paramsGenerator.GenerateNextParams(this->_currentParams))
+            {
+                if (this->_paramsGenerator.IsWaitingForReports())
+                    return false;
+                this->_generatorFinished = true;
+                return this->GenerateNextParams(params);
+            }
+            this->_nextWindow = 0;
+            InSample inSample = { static_cast<unsigned int>(this->_windows.size()), new Report(this->_logger) };
+            inSample.report->CopyParamsFrom(this->_currentParams);
+            std::map<unsigned int, InSample>::iterator old = this->_inSamples.find(this->_currentParams.GetId());
+            if (old != this->_inSamples.end())
+            {
+                delete old->second.report;
+                this->_inSamples.erase(old);
+            }
+            this->_inSamples.insert(std::make_pair(this->_currentParams.GetId(), inSample));
+        }
+        Window& w = this->_windows[this->_nextWindow];
+        params.GetDataFrom(this->_currentParams);
+        params.SetHistoryRange(w.inSampleBegin, w.outOfSampleBegin);
+        Job job = { this->_nextWindow, false };
+        this->_jobs.insert(std::make_pair(this->_GetJobKey(params), job));
+        ++w.nbPendingReports;
+        ++this->_nextWindow;
+        return true;
+    }
+
+    bool WalkForward::IsWaitingForReports() const
+    {
+        if (!this->_generatorFinished)
+            return this->_paramsGenerator.IsWaitingForReports();
+        std::vector<Window>::const_iterator it = this->_windows.begin();
+        std::vector<Window>::const_iterator itEnd = this->_windows.end();
+        for (; it != itEnd; ++it)
+            if (!it->outOfSampleGenerated)
+                return true;
+        return false;
+    }
+
+    void WalkForward::AddReport(Report const& report)
+    {
+        std::multimap<JobKey, Job>::iterator job = this->_jobs.find(this->_GetJobKey(report.GetParams()));
+        if (job == this->_jobs.end())
+        {
+            this->_logger.Log(CLASS "Unexpected report for parameters " + Tools::ToString(report.GetParams().GetId()) + ".", ::Logger::Warning);
+            return;
+        }
+        Window& w = this->_windows[job->second.window];
+        bool outOfSample = job->second.outOfSample;
+        this->_jobs.erase(job);
+        --w.nbPendingReports;
+        if (outOfSample)
+        {
+            w.outOfSample = new Report(this->_logger);
+            w.outOfSample->CopyDataFrom(report);
+            w.outOfSample->SetScore(this->_resultRanking.Rank(report));
+        }
+        else
+        {
+            if (!report.HasFailed() && !report.IsPruned())
+            {
+                float score = this->_resultRanking.Rank(report);
+                if (!w.best || score > w.bestScore)
+                {
+                    if (!w.best)
+                        w.best = new Report(this->_logger);
+                    w.best->CopyDataFrom(report);
+                    w.bestScore = score;
+                }
+            }
+            this->_AddInSampleFeedback(report);
+        }
+    }
+
+    void WalkForward::_AddInSampleFeedback(Report const& report)
+    {
+        std::map<unsigned int, InSample>::iterator it = this->_inSamples.find(report.GetParams().GetId());
+        if (it == this->_inSamples.end())
+            return;
+        InSample& inSample = it->second;
+        if (report.HasFailed())
+            inSample.report->SetFailed();
+        if (report.IsPruned())
+            inSample.report->SetPruned();
+        std::list<Report::Trade>::const_iterator trade = report.GetTrades().begin();
+        std::list<Report::Trade>::const_iterator tradeEnd = report.GetTrades().end();
+        for (; trade != tradeEnd; ++trade)
+            inSample.report->AddTrade(*trade);
+        if (--inSample.nbPendingReports)
+            return;
+        inSample.report->SetScore(this->_resultRanking.Rank(*inSample.report));
+        this->_paramsGenerator.ReportFeedback(*inSample.report);
+        delete inSample.report;
+        this->_inSamples.erase(it);
+    }
+
+    unsigned int WalkForward::GetNbTotalTasks() const
+    {
+        unsigned int nbParams = this->_paramsGenerator.GetNbTotalTasks();
+        if (!nbParams)
+            return 0;
+        return (nbParams + 1) * this->_windows.size();
+    }
+
+    void WalkForward::AddResults(ReportManager& reportManager) const
+    {
+        Report result(this->_logger);
+        for (unsigned int i = 0; i < this->_windows.size(); ++i)
+        {
+            Window const& w = this->_windows[i];
+            std::vector<Core::Bar> const& bars = this->_history.GetBars();
+            this->_logger.Log(CLASS "Window " + Tools::ToString(i + 1) + ": in-sample from " + bars[w.inSampleBegin].TimeToString() +
+                    ", out-of-sample from " + bars[w.outOfSampleBegin].TimeToString() + " to " + bars[w.outOfSampleEnd - 1].TimeToString() + ".");
+            if (!w.best || !w.outOfSample)
+            {
+                this->_logger.Log(CLASS "  No result.", ::Logger::Warning);
+                continue;
+            }
+            this->_logger.Log(CLASS "  Best in-sample " + w.best->GetParams().GetFloatParamsString() + " Score " + Tools::ToString(w.bestScore) +
+                    ", out-of-sample score " + Tools::ToString(w.outOfSample->GetScore()) + (w.outOfSample->HasFailed() ? " (failed)" : "") + ".");
+            // parameters of the last window, the ones to use next
+            result.CopyParamsFrom(w.outOfSample->GetParams());
+            std::list<Report::Trade>::const_iterator it = w.outOfSample->GetTrades().begin();
+            std::list<Report::Trade>::const_iterator itEnd = w.outOfSample->GetTrades().end();
+            for (; it != itEnd; ++it)
+                result.AddTrade(*it);
+        }
+        reportManager.AddReport(result);
+    }
+}
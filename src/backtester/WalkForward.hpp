@@ -0,0 +1,127 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_WALKFORWARD__
+#define __BACKTESTER_WALKFORWARD__
+
+#include <boost/noncopyable.hpp>
+#include <map>
+#include <vector>
+#include "StratParamsMap.hpp"
+
+namespace Core
+{
+    class History;
+}
+
+namespace Backtester
+{
+    class Logger;
+    class Conf;
+    class ParamsGenerator;
+    class Report;
+    class ReportManager;
+    class ResultRanking;
+
+    /*
+       Walk-forward analysis over the loaded history.
+
+       Windows of walkForwardInSample days are followed by walkForwardOutOfSample days and move
+       forward by walkForwardOutOfSample days. Every generated parameters are tested on every
+       in-sample window (in parallel, as any other task), then the best parameters of each window
+       are tested on its out-of-sample part. The out-of-sample trades of all the windows make the
+       final report. Each test starts with the minimal bars of the strategy taken before its window
+       (see TickGenerator::WarmUp()), without trading, so that no window starts on an empty signal.
+
+       Jobs are the generated parameters with a history range (see StratParamsMap::SetHistoryRange()).
+       The generator gets the in-sample trades of all the windows as feedback for its parameters.
+    */
+    class WalkForward :
+        private boost::noncopyable
+    {
+        public:
+            explicit WalkForward(Logger const& logger, Conf const& conf, Core::History const& history, ParamsGenerator& paramsGenerator, ResultRanking const& resultRanking);
+            ~WalkForward();
+            bool Initialize();
+            bool GenerateNextParams(StratParamsMap& params);
+
+            /*
+               True if GenerateNextParams() returned false only because the last in-sample
+               reports of a window are missing.
+            */
+            bool IsWaitingForReports() const;
+            void AddReport(Report const& report);
+            unsigned int GetNbTotalTasks() const;
+
+            /*
+               Logs the results of every window and adds the aggregated out-of-sample report.
+            */
+            void AddResults(ReportManager& reportManager) const;
+
+        private:
+            struct Window
+            {
+                unsigned int inSampleBegin;
+                unsigned int outOfSampleBegin; // end of the in-sample part
+                unsigned int outOfSampleEnd;
+                unsigned int nbPendingReports;
+                Report* best;
+                float bestScore;
+                bool outOfSampleGenerated;
+                Report* outOfSample;
+            };
+            struct InSample
+            {
+                unsigned int nbPendingReports;
+                Report* report; // trades of all the windows
+            };
+            struct Job
+            {
+                unsigned int window;
+                bool outOfSample;
+            };
+            // parameters id and history range (an out-of-sample job may be identical to an in-sample job)
+            typedef std::pair<unsigned int, std::pair<unsigned int, unsigned int> > JobKey;
+            JobKey _GetJobKey(StratParamsMap const& params) const;
+            void _AddInSampleFeedback(Report const& report);
+            Logger const& _logger;
+            Conf const& _conf;
+            Core::History const& _history;
+            ParamsGenerator& _paramsGenerator;
+            ResultRanking const& _resultRanking;
+            std::vector<Window> _windows;
+            std::multimap<JobKey, Job> _jobs;
+            std::map<unsigned int, InSample> _inSamples; // by parameters id
+            StratParamsMap _currentParams;
+            unsigned int _nextWindow;
+            bool _generatorFinished;
+    };
+}
+
+#endif
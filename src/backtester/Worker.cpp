@@ -0,0 +1,196 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <limits>
+#include <sstream>
+#include <boost/thread.hpp>
+#include "Worker.hpp"
+#include "Logger.hpp"
+#include "Conf.hpp"
+#include "StratParamsMap.hpp"
+#include "Report.hpp"
+#include "tools/ToString.hpp"
+
+#define CLASS "[Backtester/Worker] "
+
+namespace Backtester
+{
+    Worker::Worker(Logger const& logger, Conf const& conf, boost::uint64_t setupKey) :
+        _logger(logger), _conf(conf), _setupKey(setupKey), _socket(_ioService),
+        _scoreThreshold(-std::numeric_limits<float>::infinity()), _finished(false)
+    {
+    }
+
+    Worker::~Worker()
+    {
+        boost::system::error_code ignored;
+        this->_socket.close(ignored);
+        std::list<StratParamsMap*>::iterator it = this->_batch.begin();
+        std::list<StratParamsMap*>::iterator itEnd = this->_batch.end();
+        for (; it != itEnd; ++it)
+            delete *it;
+    }
+
+    bool Worker::Connect()
+    {
+        Network::Endpoint endpoint;
+        if (!Network::ParseEndpoint(this->_conf.distributedEndpoint, endpoint))
+        {
+            this->_logger.Log(CLASS "Invalid endpoint \"" + this->_conf.distributedEndpoint + "\".", ::Logger::Error);
+            return false;
+        }
+        boost::system::error_code error;
+        this->_socket.connect(endpoint, error);
+        if (error)
+        {
+            this->_logger.Log(CLASS "Failed to connect to the coordinator on \"" + this->_conf.distributedEndpoint + "\": " + error.message() + ".", ::Logger::Error);
+            return false;
+        }
+        std::ostringstream hello;
+        hello << "hello " << Network::ProtocolVersion << " " << std::hex << this->_setupKey << "\n";
+        std::string answer;
+        if (!this->_Send(hello.str()) || !this->_Receive(answer))
+            return false;
+        if (answer != "hello")
+        {
+            this->_logger.Log(CLASS "Coordinator refused the connection: \"" + answer + "\".", ::Logger::Error);
+            return false;
+        }
+        this->_logger.Log(CLASS "Connected to the coordinator on \"" + this->_conf.distributedEndpoint + "\".");
+        return true;
+    }
+
+    bool Worker::GetNewParams(StratParamsMap& params)
+    {
+        std::unique_lock<std::mutex> lock(this->_mutex);
+        while (this->_batch.empty())
+            if (this->_finished || !this->_FetchBatch(lock))
+                return false;
+        params.GetDataFrom(*this->_batch.front());
+        delete this->_batch.front();
+        this->_batch.pop_front();
+        return true;
+    }
+
+    // must be called with the mutex locked, returns false when there is nothing left to test
+    bool Worker::_FetchBatch(std::unique_lock<std::mutex>& lock)
+    {
+        std::string answer;
+        if (!this->_Send("batch\n") || !this->_Receive(answer))
+        {
+            this->_finished = true;
+            return false;
+        }
+        std::istringstream message(answer);
+        std::string type;
+        message >> type;
+        if (type == "params")
+        {
+            unsigned int size = 0;
+            float threshold;
+            message >> size;
+            if (message >> threshold)
+                this->_scoreThreshold = threshold;
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                std::string line;
+                if (!this->_Receive(line))
+                {
+                    this->_finished = true;
+                    return false;
+                }
+                std::istringstream in(line);
+                StratParamsMap* params = new StratParamsMap(this->_logger);
+                if (!params->Unserialize(in))
+                {
+                    // its report would never be sent: the coordinator requeues it when we leave
+                    this->_logger.Log(CLASS "Invalid parameters received from the coordinator.", ::Logger::Error);
+                    delete params;
+                    this->_finished = true;
+                    return false;
+                }
+                this->_batch.push_back(params);
+            }
+            return true;
+        }
+        if (type == "wait")
+        {
+            // let the other threads submit their reports meanwhile
+            lock.unlock();
+            boost::this_thread::sleep(boost::posix_time::seconds(1));
+            lock.lock();
+            return true;
+        }
+        if (type != "end")
+            this->_logger.Log(CLASS "Unexpected answer from the coordinator: \"" + answer + "\".", ::Logger::Error);
+        this->_finished = true;
+        return false;
+    }
+
+    float Worker::GetScoreThreshold() const
+    {
+        return this->_scoreThreshold;
+    }
+
+    void Worker::SubmitReport(Report const& report)
+    {
+        std::ostringstream message;
+        message << "report " << report.GetParams().GetId() << " ";
+        report.Serialize(message);
+        message << "\n";
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        this->_Send(message.str());
+    }
+
+    bool Worker::_Send(std::string const& message)
+    {
+        boost::system::error_code error;
+        boost::asio::write(this->_socket, boost::asio::buffer(message), error);
+        if (error)
+        {
+            this->_logger.Log(CLASS "Failed to send to the coordinator: " + error.message() + ".", ::Logger::Error);
+            return false;
+        }
+        return true;
+    }
+
+    bool Worker::_Receive(std::string& line)
+    {
+        boost::system::error_code error;
+        boost::asio::read_until(this->_socket, this->_buffer, '\n', error);
+        if (error)
+        {
+            this->_logger.Log(CLASS "Failed to receive from the coordinator: " + error.message() + ".", ::Logger::Error);
+            return false;
+        }
+        std::istream in(&this->_buffer);
+        std::getline(in, line);
+        return true;
+    }
+}
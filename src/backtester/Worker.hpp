@@ -0,0 +1,83 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __BACKTESTER_WORKER__
+#define __BACKTESTER_WORKER__
+
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include "Network.hpp"
+
+namespace Backtester
+{
+    class Logger;
+    class Conf;
+    class StratParamsMap;
+    class Report;
+
+    /*
+       Connection of a worker process to the coordinator, shared by all the threads of the worker.
+       Parameters are fetched by batches, reports are sent back one by one.
+    */
+    class Worker :
+        private boost::noncopyable
+    {
+        public:
+            explicit Worker(Logger const& logger, Conf const& conf, boost::uint64_t setupKey);
+            ~Worker();
+            bool Connect();
+            bool GetNewParams(StratParamsMap& params);
+            void SubmitReport(Report const& report);
+
+            /*
+               Score of the K-th best result of the coordinator (pruneTopK), as of the last batch.
+            */
+            float GetScoreThreshold() const;
+        private:
+            bool _FetchBatch(std::unique_lock<std::mutex>& lock);
+            bool _Send(std::string const& message);
+            bool _Receive(std::string& line);
+            Logger const& _logger;
+            Conf const& _conf;
+            boost::uint64_t _setupKey;
+            boost::asio::io_service _ioService;
+            Network::Socket _socket;
+            boost::asio::streambuf _buffer;
+            std::mutex _mutex;
+            std::list<StratParamsMap*> _batch;
+            std::atomic<float> _scoreThreshold;
+            bool _finished;
+    };
+}
+
+#endif
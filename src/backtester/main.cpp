@@ -33,14 +33,16 @@
 #include "conf/Conf.hpp"
 #include "Conf.hpp"
 #include "core/History.hpp"
+#include "core/StrategyInstantiator.hpp"
 
-int main(int, char**)
+int main(int ac, char** av)
 {
     // logger
     Backtester::Logger logger;
 
     // conf
-    Conf::Conf conf("backtester.lua");
+    // several processes (coordinator and workers) may run from the same directory
+    Conf::Conf conf(ac > 1 ? av[1] : "backtester.lua");
     if (conf.Error())
     {
         logger.Log("Failed to load configuration file: \"" + conf.GetLastError() + "\". Aborting.", Logger::Error);
@@ -48,6 +50,13 @@ int main(int, char**)
     }
     Backtester::Conf copyableConf(conf, logger);
 
+    // strategy plugins
+    if (!Core::StrategyInstantiator::LoadPlugins(copyableConf.strategyPlugins, logger))
+    {
+        logger.Log("Failed to load strategy plugins, aborting.", Logger::Error);
+        return boost::exit_failure;
+    }
+
     // history
     Core::History history(logger);
     if (!history.Load(conf.Read<std::string>("history", ""), conf.Read<unsigned int>("maxGapSize", 60)))
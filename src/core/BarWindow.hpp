@@ -0,0 +1,75 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __CORE_BARWINDOW__
+#define __CORE_BARWINDOW__
+
+#include <boost/noncopyable.hpp>
+#include <vector>
+#include "Bar.hpp"
+
+namespace Core
+{
+    /*
+       Fixed capacity window of the last bars, stored contiguously in a circular buffer.
+       Bars are accessed by age: window[0] is the newest bar, window[GetSize() - 1] the oldest.
+       Once the capacity is reached, adding a bar drops the oldest one (no allocation after construction).
+    */
+    class BarWindow :
+        private boost::noncopyable
+    {
+        public:
+            explicit BarWindow(unsigned int capacity);
+            void Push(Bar const& bar);
+            void Clear();
+            unsigned int GetCapacity() const;
+            bool IsEmpty() const;
+
+            /*
+               Defined here to be inlined, indicators call them for every bar.
+            */
+            unsigned int GetSize() const
+            {
+                return this->_size;
+            }
+            Bar const& operator[](unsigned int age) const
+            {
+                unsigned int i = this->_front + age;
+                if (i >= this->_bars.size())
+                    i -= this->_bars.size();
+                return this->_bars[i];
+            }
+        private:
+            std::vector<Bar> _bars;
+            unsigned int _front;
+            unsigned int _size;
+    };
+}
+
+#endif
@@ -0,0 +1,199 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __CORE_BASICCONTROLLER__
+#define __CORE_BASICCONTROLLER__
+
+#include <boost/type_traits/integral_constant.hpp>
+#include "Controller.hpp"
+#include "Feedback.hpp"
+#include "core/strategy/Strategy.hpp"
+#include "core/signal/Signal.hpp"
+#include "core/actor/Actor.hpp"
+
+#define CLASS "[Core/Controller] "
+
+namespace Core
+{
+    /*
+       Processes the packets for a strategy whose signal and actor are of type SignalType and ActorType.
+       BasicController<> goes through the virtual functions of Signal and Actor and works with any strategy.
+       With the concrete types of a strategy (declared final), the calls to Run() are resolved at compile time
+       (see Backtester::Task::_RunAs()). The signal and the actor of the strategy must be of these types.
+       With WithFeedback false, the feedback is never updated and no code is generated for it: the feedback of the
+       strategy must not be needed (see Backtester::Feedback).
+    */
+    template <class SignalType = Signal::Signal, class ActorType = Actor::Actor, bool WithFeedback = true>
+    class BasicController :
+        public Controller
+    {
+        public:
+            explicit BasicController(Strategy::Strategy& strategy);
+            void Interrupt();
+            void ProcessTick(Bar const& bar, float ask, float bid, Status status, bool newBar);
+            void ProcessTrade(Status status, float open, float lots, float sl, float tp, float askRequote, float bidRequote);
+            void ProcessBar(Bar const& bar);
+        private:
+            void _UpdateFeedback(Bar const& bar, float ask, float bid, bool newBar, boost::true_type);
+            void _UpdateFeedback(Bar const&, float, float, bool, boost::false_type) {}
+            SignalType& _signal;
+            ActorType& _actor;
+    };
+
+    template <class SignalType, class ActorType, bool WithFeedback>
+    BasicController<SignalType, ActorType, WithFeedback>::BasicController(Strategy::Strategy& strategy) :
+        Controller(strategy),
+        _signal(static_cast<SignalType&>(strategy.GetSignal())),
+        _actor(static_cast<ActorType&>(strategy.GetActor()))
+    {
+    }
+
+    template <class SignalType, class ActorType, bool WithFeedback>
+    void BasicController<SignalType, ActorType, WithFeedback>::Interrupt()
+    {
+        if (this->_actor.IsEnabled())
+            this->_actor.Stop();
+        this->_signal.ClearBars();
+        // Feedback
+        // XXX bars handling
+    }
+
+    template <class SignalType, class ActorType, bool WithFeedback>
+    void BasicController<SignalType, ActorType, WithFeedback>::ProcessTick(Bar const& bar, float ask, float bid, Status status, bool newBar)
+    {
+        this->_ResetOutput(); // this is the only packet which results in an output
+        // Tick packet processing
+        if (newBar && this->_lastBar.valid)
+            this->_signal.AddBar(this->_lastBar);
+        this->_lastBar = bar;
+        if (!this->_lastBar.valid)
+        {
+            this->_strategy.Log(CLASS "Invalid bar received while processing tick.", Logger::Warning);
+            this->_lastBar.valid = true;
+        }
+        if (this->_actor.IsEnabled()) // already trading
+        {
+            if (status != StatusNothing)
+            {
+                if (this->_actor.GetStatus() != status) // should never happen
+                {
+                    this->_output.order = OrderClose;
+                    this->_strategy.Log(CLASS "Tick packet with a different status than the actor.", Logger::Error);
+                }
+                else
+                {
+                    this->_actor.Run(this->_output, bar, ask, bid, newBar);
+                    this->_signal.NotifyTradeTick(bar, ask, bid, newBar);
+                }
+            }
+            else
+                this->_actor.Stop(); // the client closed the position
+        }
+        else // not trading
+        {
+            if (status != StatusNothing)
+                this->_strategy.Log(CLASS "Tick packet with an active status but the actor is not enabled.", Logger::Warning);
+            if (newBar || this->_signal.TriggerOnTick()) // trigger signal on new bar or on tick
+                this->_signal.Run(this->_output, bar, ask, bid, newBar);
+        }
+        // Feedback
+        this->_UpdateFeedback(bar, ask, bid, newBar, boost::integral_constant<bool, WithFeedback>());
+    }
+
+    template <class SignalType, class ActorType, bool WithFeedback>
+    void BasicController<SignalType, ActorType, WithFeedback>::_UpdateFeedback(Bar const& bar, float ask, float bid, bool newBar, boost::true_type)
+    {
+        Feedback& feedback = this->_strategy.GetFeedback();
+        if (feedback.IsNeeded())
+        {
+            feedback.SetMarketInfo(
+                    ask,
+                    bid,
+                    this->_strategy.OffsetToPips(ask - bid),
+                    bar,
+                    newBar ? 1 : feedback.GetMarketInfo().ticks + 1);
+            if (this->_actor.IsEnabled())
+            {
+                Feedback::State::Position const& pos = feedback.GetPositionInfo();
+                feedback.SetPositionInfo(
+                        pos.status,
+                        pos.open,
+                        pos.lots,
+                        pos.sl,
+                        pos.tp,
+                        this->_strategy.OffsetToPips(pos.status == Controller::StatusBuy ? bid - pos.open : pos.open - ask));
+            }
+        }
+    }
+
+    template <class SignalType, class ActorType, bool WithFeedback>
+    void BasicController<SignalType, ActorType, WithFeedback>::ProcessTrade(Status status, float open, float lots, float sl, float tp, float askRequote, float bidRequote)
+    {
+        // Trade packet processing
+        if (status == StatusUnknown) // unknown status
+            this->_strategy.Log(CLASS "Trade packet with an unknown status.", Logger::Warning);
+        else // known status (buy, sell or nothing)
+        {
+            if (this->_actor.IsEnabled()) // already trading
+            {
+                if (status != StatusBuy && status != StatusSell) // not a buy or a sell (normal actor stop)
+                    this->_actor.Stop();
+                else // currently trading (buy or sell)
+                {
+                    if (this->_actor.GetStatus() != status) // should never happen
+                        this->_strategy.Log(CLASS "Trade packet with a different status than the actor.", Logger::Error);
+                    if (this->_actor.GetSl() != sl) // sl changed
+                        this->_actor.UpdateSl(sl);
+                    if (this->_actor.GetTp() != tp) // tp changed
+                        this->_actor.UpdateTp(tp);
+                }
+            }
+            else // not trading
+            {
+                if (status != StatusBuy && status != StatusSell) // not a buy or a sell
+                    this->_strategy.Log(CLASS "Trade packet with no opened position.", Logger::Warning);
+                else // buy or sell status
+                    this->_actor.Start(status, open, lots, sl, tp, askRequote, bidRequote);
+            }
+        }
+    }
+
+    template <class SignalType, class ActorType, bool WithFeedback>
+    void BasicController<SignalType, ActorType, WithFeedback>::ProcessBar(Bar const& bar)
+    {
+        // Bar packet processing
+        this->_signal.AddBar(bar);
+        // Feedback
+        // XXX bars handling
+    }
+}
+
+#undef CLASS
+
+#endif
@@ -28,12 +28,6 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Controller.hpp"
-#include "Feedback.hpp"
-#include "core/strategy/Strategy.hpp"
-#include "core/signal/Signal.hpp"
-#include "core/actor/Actor.hpp"
-
-#define CLASS "[Core/Controller] "
 
 namespace Core
 {
@@ -55,114 +49,6 @@ namespace Core
         return this->_output;
     }
 
-    void Controller::Interrupt()
-    {
-        if (this->_strategy.GetActor().IsEnabled())
-            this->_strategy.GetActor().Stop();
-        this->_strategy.GetSignal().ClearBars();
-        // Feedback
-        // XXX bars handling
-    }
-
-    void Controller::ProcessTick(Bar const& bar, float ask, float bid, Status status, bool newBar)
-    {
-        this->_ResetOutput(); // this is the only packet which results in an output
-        // Tick packet processing
-        if (newBar && this->_lastBar.valid)
-            this->_strategy.GetSignal().AddBar(this->_lastBar);
-        this->_lastBar = bar;
-        if (!this->_lastBar.valid)
-        {
-            this->_strategy.Log(CLASS "Invalid bar received while processing tick.", Logger::Warning);
-            this->_lastBar.valid = true;
-        }
-        if (this->_strategy.GetActor().IsEnabled()) // already trading
-        {
-            if (status != StatusNothing)
-            {
-                if (this->_strategy.GetActor().GetStatus() != status) // should never happen
-                {
-                    this->_output.order = OrderClose;
-                    this->_strategy.Log(CLASS "Tick packet with a different status than the actor.", Logger::Error);
-                }
-                else
-                {
-                    this->_strategy.GetActor().Run(this->_output, bar, ask, bid, newBar);
-                    this->_strategy.GetSignal().NotifyTradeTick(bar, ask, bid, newBar);
-                }
-            }
-            else
-                this->_strategy.GetActor().Stop(); // the client closed the position
-        }
-        else // not trading
-        {
-            if (status != StatusNothing)
-                this->_strategy.Log(CLASS "Tick packet with an active status but the actor is not enabled.", Logger::Warning);
-            if (newBar || this->_strategy.GetSignal().TriggerOnTick()) // trigger signal on new bar or on tick
-                this->_strategy.GetSignal().Run(this->_output, bar, ask, bid, newBar);
-        }
-        // Feedback
-        if (this->_strategy.GetFeedback().IsNeeded())
-        {
-            this->_strategy.GetFeedback().SetMarketInfo(
-                    ask,
-                    bid,
-                    this->_strategy.OffsetToPips(ask - bid),
-                    bar,
-                    newBar ? 1 : this->_strategy.GetFeedback().GetMarketInfo().ticks + 1);
-            if (this->_strategy.GetActor().IsEnabled())
-            {
-                Feedback::State::Position const& pos = this->_strategy.GetFeedback().GetPositionInfo();
-                this->_strategy.GetFeedback().SetPositionInfo(
-                        pos.status,
-                        pos.open,
-                        pos.lots,
-                        pos.sl,
-                        pos.tp,
-                        this->_strategy.OffsetToPips(pos.status == Core::Controller::StatusBuy ? bid - pos.open : pos.open - ask));
-            }
-        }
-    }
-
-    void Controller::ProcessTrade(Status status, float open, float lots, float sl, float tp, float askRequote, float bidRequote)
-    {
-        // Trade packet processing
-        if (status == StatusUnknown) // unknown status
-            this->_strategy.Log(CLASS "Trade packet with an unknown status.", Logger::Warning);
-        else // known status (buy, sell or nothing)
-        {
-            if (this->_strategy.GetActor().IsEnabled()) // already trading
-            {
-                if (status != StatusBuy && status != StatusSell) // not a buy or a sell (normal actor stop)
-                    this->_strategy.GetActor().Stop();
-                else // currently trading (buy or sell)
-                {
-                    if (this->_strategy.GetActor().GetStatus() != status) // should never happen
-                        this->_strategy.Log(CLASS "Trade packet with a different status than the actor.", Logger::Error);
-                    if (this->_strategy.GetActor().GetSl() != sl) // sl changed
-                        this->_strategy.GetActor().UpdateSl(sl);
-                    if (this->_strategy.GetActor().GetTp() != tp) // tp changed
-                        this->_strategy.GetActor().UpdateTp(tp);
-                }
-            }
-            else // not trading
-            {
-                if (status != StatusBuy && status != StatusSell) // not a buy or a sell
-                    this->_strategy.Log(CLASS "Trade packet with no opened position.", Logger::Warning);
-                else // buy or sell status
-                    this->_strategy.GetActor().Start(status, open, lots, sl, tp, askRequote, bidRequote);
-            }
-        }
-    }
-
-    void Controller::ProcessBar(Bar const& bar)
-    {
-        // Bar packet processing
-        this->_strategy.GetSignal().AddBar(bar);
-        // Feedback
-        // XXX bars handling
-    }
-
     Strategy::Strategy& Controller::GetStrategy()
     {
         return this->_strategy;
@@ -40,11 +40,11 @@ namespace Core
     {
         class Strategy;
     }
-    namespace Actor
-    {
-        class Actor;
-    }
 
+    /*
+       Protocol values and state of a controller.
+       The packets are processed by BasicController (see BasicController.hpp).
+    */
     class Controller :
         private boost::noncopyable
     {
@@ -73,14 +73,10 @@ namespace Core
             };
             explicit Controller(Strategy::Strategy& strategy);
             Output const& GetLastOutput();
-            void Interrupt();
-            void ProcessTick(Bar const& bar, float ask, float bid, Status status, bool newBar);
-            void ProcessTrade(Status status, float open, float lots, float sl, float tp, float askRequote, float bidRequote);
-            void ProcessBar(Bar const& bar);
             Strategy::Strategy& GetStrategy();
             static char const* ToString(Status status);
             static char const* ToString(Order order);
-        private:
+        protected:
             void _ResetOutput();
             Output _output;
             Strategy::Strategy& _strategy;
@@ -31,11 +31,16 @@
 
 namespace Core
 {
-    Feedback::Feedback()
+    Feedback::Feedback(bool isNeeded) :
+        _isNeeded(isNeeded)
     {
         this->Reset();
     }
 
+    Feedback::~Feedback()
+    {
+    }
+
     Feedback::State::Market const& Feedback::GetMarketInfo() const
     {
         return this->_state.market;
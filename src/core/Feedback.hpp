@@ -73,12 +73,20 @@ namespace Core
                 Position position;
             };
 
-            explicit Feedback();
+            /*
+             * isNeeded is set by the implementation.
+             */
+            explicit Feedback(bool isNeeded);
+            virtual ~Feedback();
 
             /*
-             * No feedback is necessary if false is returned (implementation defined).
+             * No feedback is necessary if false is returned.
+             * Checked for every tick: not virtual and defined here to be inlined.
              */
-            virtual bool IsNeeded() const = 0;
+            bool IsNeeded() const
+            {
+                return this->_isNeeded;
+            }
 
             /*
              * Sets all dirty flags to false.
@@ -110,6 +118,7 @@ namespace Core
 
         private:
             State _state;
+            bool _isNeeded;
     };
 }
 
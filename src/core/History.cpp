@@ -31,6 +31,7 @@
 #include "History.hpp"
 #include "logger/Logger.hpp"
 #include "tools/ToString.hpp"
+#include "tools/Hash.hpp"
 
 #define CLASS "[Core/History] "
 
@@ -58,6 +59,21 @@ namespace Core
         return this->_bars;
     }
 
+    boost::uint64_t History::GetFingerprint() const
+    {
+        Tools::Hash h;
+        h.Add(static_cast<boost::uint64_t>(this->_bars.size()));
+        std::vector<Bar>::const_iterator it = this->_bars.begin();
+        std::vector<Bar>::const_iterator itEnd = this->_bars.end();
+        for (; it != itEnd; ++it)
+        {
+            h.Add(static_cast<boost::int64_t>(it->time)).Add(it->valid);
+            if (it->valid)
+                h.Add(it->o).Add(it->h).Add(it->l).Add(it->c);
+        }
+        return h.GetValue();
+    }
+
     unsigned int History::GetMaxGapSize() const
     {
         return this->_maxGapSize;
@@ -92,11 +108,11 @@ namespace Core
         return FetchOk;
     }
 
-    unsigned int History::GetFirstBarPosOfPeriod(unsigned int period) const
+    unsigned int History::GetFirstBarPosOfPeriod(unsigned int period, unsigned int from /* = 0 */) const
     {
         if (!period)
-            return 0;
-        unsigned int pos = 0;
+            return from;
+        unsigned int pos = from;
         unsigned int secs = period * 60;
         while (pos < this->_bars.size() && this->_bars[pos].time % secs)
             ++pos;
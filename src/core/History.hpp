@@ -33,6 +33,7 @@
 #include <boost/noncopyable.hpp>
 #include <string>
 #include <vector>
+#include <boost/cstdint.hpp>
 #include "Bar.hpp"
 
 namespace Logger
@@ -86,10 +87,10 @@ namespace Core
             unsigned int GetBarPosFromDate(time_t time, bool& success) const;
 
             /*
-               Returns a position in 1 minute bars corresponding to the beginning of the first bar of period.
+               Returns a position in 1 minute bars corresponding to the beginning of the first bar of period at or after from.
                It may return an invalid value if the first bar of period is too close to the end.
              */
-            unsigned int GetFirstBarPosOfPeriod(unsigned int period) const;
+            unsigned int GetFirstBarPosOfPeriod(unsigned int period, unsigned int from = 0) const;
 
             /*
                Returns the maximum gap size.
@@ -101,6 +102,11 @@ namespace Core
             */
             void CopyDataFrom(History const& history);
 
+            /*
+               Returns a hash of the bars (times, validity and OHLC values), not of the path.
+            */
+            boost::uint64_t GetFingerprint() const;
+
         private:
             unsigned int _VerifyHistory();
             void _ShowTransitionQuality() const;
@@ -41,6 +41,108 @@ namespace Core
     {
     }
 
+    unsigned int StratParams::DeclareFloat(std::string const& name, float defaultValue)
+    {
+        for (unsigned int slot = 0; slot < this->_floatSchema.size(); ++slot)
+            if (this->_floatSchema[slot].first == name)
+                return slot;
+        this->_floatSchema.push_back(std::make_pair(name, defaultValue));
+        this->_floatSlots.push_back(this->GetFloat(name, defaultValue));
+        return this->_floatSlots.size() - 1;
+    }
+
+    unsigned int StratParams::DeclareString(std::string const& name, std::string const& defaultValue)
+    {
+        for (unsigned int slot = 0; slot < this->_stringSchema.size(); ++slot)
+            if (this->_stringSchema[slot].first == name)
+                return slot;
+        this->_stringSchema.push_back(std::make_pair(name, defaultValue));
+        this->_stringSlots.push_back(this->GetString(name, defaultValue));
+        return this->_stringSlots.size() - 1;
+    }
+
+    float StratParams::GetFloatSlot(unsigned int slot) const
+    {
+        return this->_floatSlots[slot];
+    }
+
+    std::string const& StratParams::GetStringSlot(unsigned int slot) const
+    {
+        return this->_stringSlots[slot];
+    }
+
+    void StratParams::SetFloatSlot(unsigned int slot, float value)
+    {
+        this->_floatSlots[slot] = value;
+    }
+
+    void StratParams::SetStringSlot(unsigned int slot, std::string const& value)
+    {
+        this->_stringSlots[slot] = value;
+    }
+
+    unsigned int StratParams::GetNbFloatSlots() const
+    {
+        return this->_floatSlots.size();
+    }
+
+    unsigned int StratParams::GetNbStringSlots() const
+    {
+        return this->_stringSlots.size();
+    }
+
+    std::string const& StratParams::GetFloatSlotName(unsigned int slot) const
+    {
+        return this->_floatSchema[slot].first;
+    }
+
+    std::string const& StratParams::GetStringSlotName(unsigned int slot) const
+    {
+        return this->_stringSchema[slot].first;
+    }
+
+    float StratParams::GetFloatSlotDefault(unsigned int slot) const
+    {
+        return this->_floatSchema[slot].second;
+    }
+
+    std::string const& StratParams::GetStringSlotDefault(unsigned int slot) const
+    {
+        return this->_stringSchema[slot].second;
+    }
+
+    bool StratParams::FindFloatSlot(std::string const& name, unsigned int& slot) const
+    {
+        for (slot = 0; slot < this->_floatSchema.size(); ++slot)
+            if (this->_floatSchema[slot].first == name)
+                return true;
+        return false;
+    }
+
+    bool StratParams::FindStringSlot(std::string const& name, unsigned int& slot) const
+    {
+        for (slot = 0; slot < this->_stringSchema.size(); ++slot)
+            if (this->_stringSchema[slot].first == name)
+                return true;
+        return false;
+    }
+
+    void StratParams::UpdateSlots()
+    {
+        for (unsigned int slot = 0; slot < this->_floatSlots.size(); ++slot)
+            this->_floatSlots[slot] = this->GetFloat(this->_floatSchema[slot].first, this->_floatSchema[slot].second);
+        for (unsigned int slot = 0; slot < this->_stringSlots.size(); ++slot)
+            this->_stringSlots[slot] = this->GetString(this->_stringSchema[slot].first, this->_stringSchema[slot].second);
+    }
+
+    void StratParams::ClearSlots()
+    {
+        this->_floatSlots.clear();
+        this->_stringSlots.clear();
+        this->_floatSchema.clear();
+        this->_stringSchema.clear();
+    }
+
     void StratParams::Log(std::string const& msg, Logger::MessageType type /* = Logger::Info */) const
     {
         this->_logger.Log(msg, type);
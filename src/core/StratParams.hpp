@@ -32,6 +32,8 @@
 
 #include <boost/noncopyable.hpp>
 #include <string>
+#include <vector>
+#include <utility>
 #include "logger/Logger.hpp"
 
 namespace Core
@@ -49,9 +51,49 @@ namespace Core
             virtual float GetFloat(std::string const& name, float defaultValue) = 0;
             virtual std::string GetString(std::string const& name, std::string const& defaultValue) = 0;
 
+            /*
+               Slots: a strategy declares each of its parameters once (in the constructors of its signal, actor and
+               indicators) and then reads it by index from a flat array, without lookup nor virtual call.
+               Declaring the same name again returns the same slot. The value is read with GetFloat() or GetString()
+               when first declared, then again for every slot by UpdateSlots().
+            */
+            unsigned int DeclareFloat(std::string const& name, float defaultValue);
+            unsigned int DeclareString(std::string const& name, std::string const& defaultValue);
+            float GetFloatSlot(unsigned int slot) const;
+            std::string const& GetStringSlot(unsigned int slot) const;
+            void SetFloatSlot(unsigned int slot, float value);
+            void SetStringSlot(unsigned int slot, std::string const& value);
+            unsigned int GetNbFloatSlots() const;
+            unsigned int GetNbStringSlots() const;
+            std::string const& GetFloatSlotName(unsigned int slot) const;
+            std::string const& GetStringSlotName(unsigned int slot) const;
+            float GetFloatSlotDefault(unsigned int slot) const;
+            std::string const& GetStringSlotDefault(unsigned int slot) const;
+
+            /*
+               false -> No slot is declared with this name.
+            */
+            bool FindFloatSlot(std::string const& name, unsigned int& slot) const;
+            bool FindStringSlot(std::string const& name, unsigned int& slot) const;
+
+            /*
+               Reads the value of every slot again after the parameters changed (see StrategyInstantiator::Recycle()).
+               The base implementation calls GetFloat() and GetString().
+            */
+            virtual void UpdateSlots();
+
+            /*
+               Forgets the declared slots (the strategy using them is destroyed).
+            */
+            void ClearSlots();
+
             void Log(std::string const& msg, Logger::MessageType type = Logger::Info) const;
         private:
             Logger::Logger const& _logger;
+            std::vector<float> _floatSlots;
+            std::vector<std::string> _stringSlots;
+            std::vector<std::pair<std::string, float> > _floatSchema; // name and default value of each slot
+            std::vector<std::pair<std::string, std::string> > _stringSchema;
     };
 }
 
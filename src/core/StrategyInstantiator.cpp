@@ -27,19 +27,19 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <dlfcn.h>
 #include "StrategyInstantiator.hpp"
 #include "Feedback.hpp"
 #include "StratParams.hpp"
 #include "logger/Logger.hpp"
 #include "core/strategy/Strategy.hpp"
-#include "core/strategy/MaCross.hpp"
 
 #define CLASS "[Core/StrategyInstantiator] "
 
 namespace Core
 {
     StrategyInstantiator::StrategyInstantiator(Logger::Logger const& logger, Feedback& feedback, StratParams& stratParams) :
-        _logger(logger), _feedback(feedback), _stratParams(stratParams), _strategy(0)
+        _logger(logger), _feedback(feedback), _stratParams(stratParams), _strategy(0), _period(0), _digits(0)
     {
     }
 
@@ -57,11 +57,13 @@ namespace Core
             return false;
         }
 
-        if (name == "MaCross")
-            this->_strategy = new Strategy::MaCross(this->_logger, this->_feedback, pair, period, digits, this->_stratParams);
-        // else if (name == "OtherStrategy")
-        //     this->_strategy = new Strategy::OtherStrategy(...) // add more strategies here
-
+        StrategyFactory factory = StrategyRegistry::GetInstance().Find(name);
+        if (!factory)
+        {
+            this->_logger.Log(CLASS "Strategy \"" + name + "\" not found (available: " + StrategyRegistry::GetInstance().GetNamesString() + ").");
+            return 0;
+        }
+        this->_strategy = factory(this->_logger, this->_feedback, pair, period, digits, this->_stratParams);
         if (!this->_strategy)
         {
             this->_logger.Log(CLASS "Failed to create strategy \"" + name + "\".");
@@ -72,14 +74,39 @@ namespace Core
             this->_logger.Log(CLASS "Failed to initialize strategy \"" + this->_strategy->GetName() + "\".");
             delete this->_strategy;
             this->_strategy = 0;
+            this->_stratParams.ClearSlots();
             return 0;
         }
         this->_logger.Log(CLASS "Strategy \"" + this->_strategy->GetName() + "\" initialized successfully.");
+        this->_name = name;
+        this->_pair = pair;
+        this->_period = period;
+        this->_digits = digits;
         if (this->_feedback.IsNeeded())
             this->_feedback.SetBarsInfo(pair, period, digits);
         return true;
     }
 
+    bool StrategyInstantiator::Recycle(std::string const& name, std::string const& pair, unsigned int period, unsigned int digits)
+    {
+        if (this->_strategy)
+        {
+            if (name == this->_name && pair == this->_pair && period == this->_period && digits == this->_digits)
+            {
+                this->_feedback.Reset();
+                this->_stratParams.UpdateSlots();
+                if (this->_strategy->Reset())
+                {
+                    if (this->_feedback.IsNeeded())
+                        this->_feedback.SetBarsInfo(pair, period, digits);
+                    return true;
+                }
+            }
+            this->Destroy();
+        }
+        return this->Instantiate(name, pair, period, digits);
+    }
+
     Strategy::Strategy* StrategyInstantiator::GetStrategy() const
     {
         return this->_strategy;
@@ -102,5 +129,45 @@ namespace Core
         delete this->_strategy;
         this->_strategy = 0;
         this->_feedback.Reset();
+        this->_stratParams.ClearSlots();
+    }
+
+    bool StrategyInstantiator::LoadPlugins(std::string const& paths, Logger::Logger const& logger)
+    {
+        bool loaded = true;
+        std::vector<std::string> const& rejectedNames = StrategyRegistry::GetInstance().GetRejectedNames();
+        // strategies of the executable itself
+        std::vector<std::string>::size_type nbRejected = rejectedNames.size();
+        for (std::vector<std::string>::size_type i = 0; i < nbRejected; ++i)
+        {
+            logger.Log(CLASS "Strategy \"" + rejectedNames[i] + "\" registered twice, the second one is ignored.", Logger::Error);
+            loaded = false;
+        }
+        std::string::size_type begin = 0;
+        while (begin < paths.size())
+        {
+            std::string::size_type end = paths.find(',', begin);
+            if (end == std::string::npos)
+                end = paths.size();
+            std::string path = paths.substr(begin, end - begin);
+            begin = end + 1;
+            if (path.empty())
+                continue;
+            // the handle is dropped: the registered factories point into the library
+            if (!dlopen(path.c_str(), RTLD_NOW | RTLD_GLOBAL))
+            {
+                logger.Log(CLASS "Failed to load strategy plugin \"" + path + "\": " + dlerror() + ".", Logger::Warning);
+                loaded = false;
+            }
+            else if (rejectedNames.size() != nbRejected)
+            {
+                for (; nbRejected < rejectedNames.size(); ++nbRejected)
+                    logger.Log(CLASS "Strategy plugin \"" + path + "\" registers strategy \"" + rejectedNames[nbRejected] + "\" which is already registered, ignored.", Logger::Error);
+                loaded = false;
+            }
+            else
+                logger.Log(CLASS "Strategy plugin \"" + path + "\" loaded.");
+        }
+        return loaded;
     }
 }
@@ -32,6 +32,7 @@
 
 #include <boost/noncopyable.hpp>
 #include <string>
+#include "tools/Registry.hpp"
 
 namespace Logger
 {
@@ -47,6 +48,34 @@ namespace Core
     class Feedback;
     class StratParams;
 
+    typedef Strategy::Strategy* (*StrategyFactory)(Logger::Logger const& logger,
+            Feedback& feedback,
+            std::string const& pair,
+            unsigned int period,
+            unsigned int digits,
+            StratParams& stratParams);
+
+    /*
+       Strategies known by StrategyInstantiator. Each strategy registers itself in its own translation unit:
+           namespace
+           {
+               StrategyRegistry::Registrar registrar("MaCross", &CreateStrategy<Strategy::MaCross>);
+           }
+       Strategies can also be shipped in a shared library doing the same (see StrategyInstantiator::LoadPlugins()).
+    */
+    typedef Tools::Registry<StrategyFactory> StrategyRegistry;
+
+    template <class T>
+        Strategy::Strategy* CreateStrategy(Logger::Logger const& logger,
+                Feedback& feedback,
+                std::string const& pair,
+                unsigned int period,
+                unsigned int digits,
+                StratParams& stratParams)
+        {
+            return new T(logger, feedback, pair, period, digits, stratParams);
+        }
+
     class StrategyInstantiator :
         private boost::noncopyable
     {
@@ -57,14 +86,35 @@ namespace Core
             explicit StrategyInstantiator(Logger::Logger const& logger, Feedback& feedback, StratParams& stratParams);
             ~StrategyInstantiator();
             bool Instantiate(std::string const& name, std::string const& pair, unsigned int period, unsigned int digits);
+
+            /*
+               Same as Instantiate(), but when a strategy with the same name, pair, period and digits is already
+               instantiated, it is reset with the current content of stratParams (see Strategy::Reset()) instead of
+               being destroyed and created again. Meant for running many tests in a row with the same objects.
+               The parameter slots of the strategy are updated before the reset (see StratParams::UpdateSlots()).
+            */
+            bool Recycle(std::string const& name, std::string const& pair, unsigned int period, unsigned int digits);
             Strategy::Strategy* GetStrategy() const;
             void Destroy();
             bool StrategyInstantiated() const;
+
+            /*
+               Loads the strategy plugins of the comma separated list of paths, before any instantiation.
+               A plugin is a shared library whose strategies register themselves in StrategyRegistry when loaded
+               (built against the same sources, the executables export their symbols). Plugins are never unloaded.
+               false -> At least one of the plugins could not be loaded, or a strategy name was registered twice (by a
+               plugin or by the executable), in which case the first registered strategy is kept.
+            */
+            static bool LoadPlugins(std::string const& paths, Logger::Logger const& logger);
         private:
             Logger::Logger const& _logger;
             Feedback& _feedback;
             StratParams& _stratParams;
             Strategy::Strategy* _strategy;
+            std::string _name;
+            std::string _pair;
+            unsigned int _period;
+            unsigned int _digits;
     };
 }
 
@@ -55,6 +55,11 @@ namespace Core
             this->_logStartStop = logStartStop;
         }
 
+        void Actor::Reset(StratParams&)
+        {
+            this->_Disable();
+        }
+
         void Actor::Start(Controller::Status status, float open, float lots, float sl, float tp, float askRequote, float bidRequote)
         {
             if (status != Controller::StatusBuy && status != Controller::StatusSell)
@@ -130,7 +135,7 @@ namespace Core
             return this->_strategy;
         }
 
-        std::list<Bar> const& Actor::GetBars() const
+        BarWindow const& Actor::GetBars() const
         {
             return this->_strategy.GetSignal().GetBars();
         }
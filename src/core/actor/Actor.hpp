@@ -31,12 +31,14 @@
 #define __CORE_ACTOR_ACTOR__
 
 #include <boost/noncopyable.hpp>
-#include <list>
 #include "core/Controller.hpp"
+#include "core/BarWindow.hpp"
 #include "logger/Logger.hpp"
 
 namespace Core
 {
+    class StratParams;
+
     namespace Strategy
     {
         class Strategy;
@@ -58,7 +60,7 @@ namespace Core
                 std::string const& GetName() const;
                 Strategy::Strategy& GetStrategy();
                 void Log(std::string const& msg, Logger::MessageType type = Logger::Info);
-                std::list<Bar> const& GetBars() const;
+                BarWindow const& GetBars() const;
                 void SetLogStartStop(bool logStartStop);
 
                 /*
@@ -78,6 +80,12 @@ namespace Core
                  */
                 virtual void Run(Controller::Output& output, Bar const& bar, float ask, float bid, bool newBar) = 0;
 
+                /*
+                   Called when the strategy is reused for another set of parameters (see Strategy::Reset()).
+                   Must read the parameters again. The base implementation disables the actor.
+                 */
+                virtual void Reset(StratParams& stratParams);
+
             private:
 
                 /*
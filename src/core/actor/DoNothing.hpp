@@ -36,7 +36,7 @@ namespace Core
 {
     namespace Actor
     {
-        class DoNothing :
+        class DoNothing final :
             public Actor
         {
             public:
@@ -40,13 +40,23 @@ namespace Core
     {
         TrailingStop::TrailingStop(Strategy::Strategy& strategy, StratParams& stratParams) :
             Actor(strategy, "TrailingStop"),
-            _debug(stratParams.GetString("tsLog", "normal") == "debug"),
-            _distance(stratParams.GetFloat("tsDistance", 5))
+            _debugSlot(stratParams.DeclareString("tsLog", "normal")),
+            _distanceSlot(stratParams.DeclareFloat("tsDistance", 5)),
+            _debug(stratParams.GetStringSlot(this->_debugSlot) == "debug"),
+            _distance(stratParams.GetFloatSlot(this->_distanceSlot))
         {
         }
 
+        void TrailingStop::Reset(StratParams& stratParams)
+        {
+            Actor::Reset(stratParams);
+            this->_debug = stratParams.GetStringSlot(this->_debugSlot) == "debug";
+            this->_distance = stratParams.GetFloatSlot(this->_distanceSlot);
+        }
+
         bool TrailingStop::_Start()
         {
+            this->_UpdateTp();
             if (this->GetStatus() == Core::Controller::StatusBuy)
             {
                 this->_stop = this->GetBidRequote() - this->GetStrategy().PipsToOffset(this->_distance);
@@ -124,6 +134,11 @@ namespace Core
 
         void TrailingStop::_UpdateTp()
         {
+            // distance of the TP from the opening price
+            if (this->GetStatus() == Core::Controller::StatusBuy)
+                this->_tp = this->GetTp() - this->GetOpen();
+            else
+                this->_tp = this->GetOpen() - this->GetTp();
         }
     }
 }
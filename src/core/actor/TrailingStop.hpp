@@ -38,17 +38,20 @@ namespace Core
 
     namespace Actor
     {
-        class TrailingStop :
+        class TrailingStop final :
             public Actor
         {
             public:
                 explicit TrailingStop(Strategy::Strategy& strategy, StratParams& stratParams);
                 virtual void Run(Controller::Output& state, Bar const& bar, float ask, float bid, bool newBar);
+                virtual void Reset(StratParams& stratParams);
             private:
                 virtual bool _Start();
                 virtual void _Stop();
                 virtual void _UpdateSl();
                 virtual void _UpdateTp();
+                unsigned int _debugSlot;
+                unsigned int _distanceSlot;
                 bool _debug;
                 float _stop;
                 float _tp;
@@ -0,0 +1,104 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "AverageTrueRange.hpp"
+
+namespace Core
+{
+    namespace Indicator
+    {
+        AverageTrueRange::AverageTrueRange(Strategy::Strategy& strategy, unsigned int period) :
+            Indicator(strategy, "AverageTrueRange", 1),
+            _period(this->_CheckPeriod(period)),
+            _atr(this->_period, 1.0 / this->_period)
+        {
+        }
+
+        void AverageTrueRange::NotifyBarAdded(Bar const& bar)
+        {
+            BarWindow const& bars = this->GetBars();
+            float high = bar.h;
+            float low = bar.l;
+            if (bars.GetSize() >= 2)
+            {
+                float prevClose = bars[1].c;
+                if (prevClose > high)
+                    high = prevClose;
+                if (prevClose < low)
+                    low = prevClose;
+            }
+            this->_atr.Add(high - low);
+        }
+
+        void AverageTrueRange::NotifyBarsCleared()
+        {
+            this->_atr.Clear();
+            this->_SetValidity(false);
+        }
+
+        void AverageTrueRange::Run()
+        {
+            this->_SetValidity(this->_atr.IsReady());
+            if (this->IsValid())
+                this->_SetOutput(OutputAtr, this->_atr.GetValue());
+        }
+
+        unsigned int AverageTrueRange::ComputeSeries(std::vector<float> const& highs, std::vector<float> const& lows, std::vector<float> const& closes, unsigned int period, std::vector<float>& output)
+        {
+            unsigned int size = closes.size();
+            if (!period)
+                period = 1;
+            output.assign(size, 0);
+            if (highs.size() != size || lows.size() != size)
+                return size;
+            ExpSmoothing atr(period, 1.0 / period);
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                float high = highs[i];
+                float low = lows[i];
+                if (i)
+                {
+                    if (closes[i - 1] > high)
+                        high = closes[i - 1];
+                    if (closes[i - 1] < low)
+                        low = closes[i - 1];
+                }
+                atr.Add(high - low);
+                if (atr.IsReady())
+                    output[i] = atr.GetValue();
+            }
+            return size < period ? size : period - 1;
+        }
+
+        unsigned int AverageTrueRange::GetPeriod() const
+        {
+            return this->_period;
+        }
+    }
+}
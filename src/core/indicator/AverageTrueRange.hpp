@@ -0,0 +1,69 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __CORE_INDICATOR_AVERAGETRUERANGE__
+#define __CORE_INDICATOR_AVERAGETRUERANGE__
+
+#include "Indicator.hpp"
+#include "Streaming.hpp"
+
+namespace Core
+{
+    namespace Indicator
+    {
+        /*
+         * Average true range (price offset, not pips), with Wilder's smoothing.
+         * The true range of the first bar after a clear is its high - low.
+         */
+        class AverageTrueRange :
+            public Indicator
+        {
+            public:
+                enum
+                {
+                    OutputAtr = 0,
+                };
+                explicit AverageTrueRange(Strategy::Strategy& strategy, unsigned int period);
+                virtual void Run();
+                virtual void NotifyBarAdded(Bar const& bar);
+                virtual void NotifyBarsCleared();
+                unsigned int GetPeriod() const;
+
+                /*
+                   There is no valid output if highs, lows and closes do not have the same size.
+                */
+                static unsigned int ComputeSeries(std::vector<float> const& highs, std::vector<float> const& lows, std::vector<float> const& closes, unsigned int period, std::vector<float>& output);
+            private:
+                unsigned int _period;
+                ExpSmoothing _atr;
+        };
+    }
+}
+
+#endif
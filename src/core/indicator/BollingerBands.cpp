@@ -0,0 +1,129 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cmath>
+#include "BollingerBands.hpp"
+
+namespace Core
+{
+    namespace Indicator
+    {
+        BollingerBands::BollingerBands(Strategy::Strategy& strategy, unsigned int period, float deviations) :
+            Indicator(strategy, "BollingerBands", 3),
+            _period(this->_CheckWindowPeriod(period, 2)),
+            _deviations(deviations)
+        {
+            this->NotifyBarsCleared();
+        }
+
+        void BollingerBands::_Add(Moments& moments, double value)
+        {
+            ++moments.count;
+            double delta = value - moments.mean;
+            moments.mean += delta / moments.count;
+            moments.m2 += delta * (value - moments.mean);
+        }
+
+        void BollingerBands::_Replace(Moments& moments, double old, double value)
+        {
+            double oldMean = moments.mean;
+            moments.mean += (value - old) / moments.count;
+            moments.m2 += (value - old) * (value - moments.mean + old - oldMean);
+            if (moments.m2 < 0)
+                moments.m2 = 0;
+        }
+
+        void BollingerBands::NotifyBarAdded(Bar const& bar)
+        {
+            if (this->_moments.count < this->_period)
+                _Add(this->_moments, bar.c);
+            else
+                _Replace(this->_moments, this->GetBars()[this->_period].c, bar.c); // the close leaving the window
+        }
+
+        void BollingerBands::NotifyBarsCleared()
+        {
+            this->_moments.count = 0;
+            this->_moments.mean = 0;
+            this->_moments.m2 = 0;
+            this->_SetValidity(false);
+        }
+
+        void BollingerBands::Run()
+        {
+            this->_SetValidity(this->_moments.count == this->_period);
+            if (!this->IsValid())
+                return;
+            double offset = this->_deviations * std::sqrt(this->_moments.m2 / this->_period);
+            this->_SetOutput(OutputMiddle, this->_moments.mean);
+            this->_SetOutput(OutputUpper, this->_moments.mean + offset);
+            this->_SetOutput(OutputLower, this->_moments.mean - offset);
+        }
+
+        unsigned int BollingerBands::ComputeSeries(std::vector<float> const& closes, unsigned int period, float deviations,
+                std::vector<float>& middle, std::vector<float>& upper, std::vector<float>& lower)
+        {
+            unsigned int size = closes.size();
+            if (period < 2)
+                period = 2;
+            middle.assign(size, 0);
+            upper.assign(size, 0);
+            lower.assign(size, 0);
+            Moments moments;
+            moments.count = 0;
+            moments.mean = 0;
+            moments.m2 = 0;
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                if (moments.count < period)
+                    _Add(moments, closes[i]);
+                else
+                    _Replace(moments, closes[i - period], closes[i]);
+                if (moments.count == period)
+                {
+                    double offset = deviations * std::sqrt(moments.m2 / period);
+                    middle[i] = moments.mean;
+                    upper[i] = moments.mean + offset;
+                    lower[i] = moments.mean - offset;
+                }
+            }
+            return size < period ? size : period - 1;
+        }
+
+        unsigned int BollingerBands::GetPeriod() const
+        {
+            return this->_period;
+        }
+
+        float BollingerBands::GetDeviations() const
+        {
+            return this->_deviations;
+        }
+    }
+}
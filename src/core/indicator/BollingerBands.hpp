@@ -0,0 +1,77 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __CORE_INDICATOR_BOLLINGERBANDS__
+#define __CORE_INDICATOR_BOLLINGERBANDS__
+
+#include "Indicator.hpp"
+
+namespace Core
+{
+    namespace Indicator
+    {
+        /*
+         * Simple moving average of the closes plus and minus deviations times their standard deviation.
+         * The mean and the variance of the window are updated with Welford's method.
+         */
+        class BollingerBands :
+            public Indicator
+        {
+            public:
+                enum
+                {
+                    OutputMiddle = 0,
+                    OutputUpper = 1,
+                    OutputLower = 2,
+                };
+                explicit BollingerBands(Strategy::Strategy& strategy, unsigned int period, float deviations);
+                virtual void Run();
+                virtual void NotifyBarAdded(Bar const& bar);
+                virtual void NotifyBarsCleared();
+                unsigned int GetPeriod() const;
+                float GetDeviations() const;
+                static unsigned int ComputeSeries(std::vector<float> const& closes, unsigned int period, float deviations,
+                        std::vector<float>& middle, std::vector<float>& upper, std::vector<float>& lower);
+            private:
+                struct Moments
+                {
+                    unsigned int count;
+                    double mean;
+                    double m2; // sum of the squared differences to the mean
+                };
+                static void _Add(Moments& moments, double value);
+                static void _Replace(Moments& moments, double old, double value);
+                unsigned int _period;
+                float _deviations;
+                Moments _moments;
+        };
+    }
+}
+
+#endif
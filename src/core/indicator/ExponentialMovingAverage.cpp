@@ -0,0 +1,82 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "ExponentialMovingAverage.hpp"
+
+namespace Core
+{
+    namespace Indicator
+    {
+        ExponentialMovingAverage::ExponentialMovingAverage(Strategy::Strategy& strategy, unsigned int period) :
+            Indicator(strategy, "ExponentialMovingAverage", 1),
+            _period(this->_CheckPeriod(period, 2)),
+            _ema(this->_period, 2.0 / (this->_period + 1))
+        {
+        }
+
+        void ExponentialMovingAverage::NotifyBarAdded(Bar const& bar)
+        {
+            this->_ema.Add(bar.c);
+        }
+
+        void ExponentialMovingAverage::NotifyBarsCleared()
+        {
+            this->_ema.Clear();
+            this->_SetValidity(false);
+        }
+
+        void ExponentialMovingAverage::Run()
+        {
+            this->_SetValidity(this->_ema.IsReady());
+            if (this->IsValid())
+                this->_SetOutput(OutputMovingAverage, this->_ema.GetValue());
+        }
+
+        unsigned int ExponentialMovingAverage::ComputeSeries(std::vector<float> const& closes, unsigned int period, std::vector<float>& output)
+        {
+            unsigned int size = closes.size();
+            if (period < 2)
+                period = 2;
+            output.assign(size, 0);
+            ExpSmoothing ema(period, 2.0 / (period + 1));
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                ema.Add(closes[i]);
+                if (ema.IsReady())
+                    output[i] = ema.GetValue();
+            }
+            return size < period ? size : period - 1;
+        }
+
+        unsigned int ExponentialMovingAverage::GetPeriod() const
+        {
+            return this->_period;
+        }
+    }
+}
@@ -30,6 +30,7 @@
 #include "Indicator.hpp"
 #include "core/signal/Signal.hpp"
 #include "core/strategy/Strategy.hpp"
+#include "tools/ToString.hpp"
 
 #define CLASS "[Core/Indicator/Indicator] "
 
@@ -38,7 +39,7 @@ namespace Core
     namespace Indicator
     {
         Indicator::Indicator(Strategy::Strategy& strategy, std::string const& name, unsigned int nbOutputs) :
-            _strategy(strategy), _name(name), _valid(false)
+            _strategy(strategy), _name(name), _valid(false), _bars(0)
         {
             if (nbOutputs < 1)
             {
@@ -48,11 +49,30 @@ namespace Core
             this->_outputs.resize(nbOutputs);
         }
 
-        std::list<Bar> const& Indicator::GetBars() const
+        Indicator::~Indicator()
         {
+        }
+
+        void Indicator::NotifyBarAdded(Bar const&)
+        {
+        }
+
+        void Indicator::NotifyBarsCleared()
+        {
+        }
+
+        BarWindow const& Indicator::GetBars() const
+        {
+            if (this->_bars)
+                return *this->_bars;
             return this->_strategy.GetSignal().GetBars();
         }
 
+        void Indicator::SetBars(BarWindow const& bars)
+        {
+            this->_bars = &bars;
+        }
+
         unsigned int Indicator::GetNbOutputs() const
         {
             return this->_outputs.size();
@@ -89,6 +109,29 @@ namespace Core
             this->_valid = validity;
         }
 
+        unsigned int Indicator::_CheckPeriod(unsigned int period, unsigned int minPeriod /* = 1 */)
+        {
+            if (period >= minPeriod)
+                return period;
+            this->_strategy.Log(CLASS "Invalid period of " + Tools::ToString(period) + " for indicator \"" + this->_name + "\", changing to " + Tools::ToString(minPeriod) + ".", Logger::Warning);
+            return minPeriod;
+        }
+
+        unsigned int Indicator::_CheckWindowPeriod(unsigned int period, unsigned int minPeriod /* = 1 */)
+        {
+            if (period < Signal::Signal::MaxBars)
+                return this->_CheckPeriod(period, minPeriod);
+            this->_strategy.Log(CLASS "Invalid period of " + Tools::ToString(period) + " for indicator \"" + this->_name + "\", changing to " + Tools::ToString(Signal::Signal::MaxBars - 1) + ".", Logger::Warning);
+            return Signal::Signal::MaxBars - 1;
+        }
+
+        void Indicator::GetColumn(std::vector<Bar> const& bars, float Bar::* field, std::vector<float>& column)
+        {
+            column.resize(bars.size());
+            for (unsigned int i = 0; i < bars.size(); ++i)
+                column[i] = bars[i].*field;
+        }
+
         std::string const& Indicator::GetName() const
         {
             return this->_name;
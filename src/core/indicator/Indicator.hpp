@@ -33,8 +33,7 @@
 #include <boost/noncopyable.hpp>
 #include <string>
 #include <vector>
-#include <list>
-#include "core/Bar.hpp"
+#include "core/BarWindow.hpp"
 #include "logger/Logger.hpp"
 
 namespace Core
@@ -51,6 +50,7 @@ namespace Core
         {
             public:
                 explicit Indicator(Strategy::Strategy& strategy, std::string const& name, unsigned int nbOutputs);
+                virtual ~Indicator();
 
                 /*
                  * After returning, the validity has been changed to true or false.
@@ -58,22 +58,57 @@ namespace Core
                  */
                 virtual void Run() = 0;
 
+                /*
+                 * Called by the signal the indicator is registered to (see Signal::_RegisterIndicator()),
+                 * after a bar was added at the front of the bars or after the bars were cleared.
+                 * Allows an indicator to update its state incrementally instead of reading all the bars in Run().
+                 * The base implementation does nothing.
+                 */
+                virtual void NotifyBarAdded(Bar const& bar);
+                virtual void NotifyBarsCleared();
+
                 std::string const& GetName() const;
                 float GetOutput(unsigned int key) const;
                 std::vector<float> const& GetOutputs() const;
                 bool IsValid() const;
                 Strategy::Strategy& GetStrategy();
                 unsigned int GetNbOutputs() const;
-                std::list<Bar> const& GetBars() const;
+                BarWindow const& GetBars() const;
+
+                /*
+                 * Called by the signal when registering the indicator (the bars of the strategy's period are used by default).
+                 */
+                void SetBars(BarWindow const& bars);
                 void Log(std::string const& msg, Logger::MessageType type = Logger::Info);
+
+                /*
+                 * Columnar evaluation: indicators also have a static ComputeSeries() computing a whole series of outputs
+                 * from chronological columns (oldest value first), for example taken from the history with GetColumn().
+                 * The output vectors get the size of the inputs. The returned index is the one of the first valid output
+                 * (the size of the inputs if there is none), the values before it are set to 0.
+                 * The values are the ones given by the incremental version after each bar.
+                 */
+                static void GetColumn(std::vector<Bar> const& bars, float Bar::* field, std::vector<float>& column);
             protected:
                 void _SetOutput(unsigned int key, float value);
                 void _SetValidity(bool validity);
+
+                /*
+                 * Returns period, or minPeriod with a warning if period is lower.
+                 */
+                unsigned int _CheckPeriod(unsigned int period, unsigned int minPeriod = 1);
+
+                /*
+                 * Same as _CheckPeriod(), for indicators reading the bar leaving their window (GetBars()[period]):
+                 * the period must also be lower than the capacity of the window (Signal::MaxBars).
+                 */
+                unsigned int _CheckWindowPeriod(unsigned int period, unsigned int minPeriod = 1);
             private:
                 Strategy::Strategy& _strategy;
                 std::string _name;
                 std::vector<float> _outputs;
                 bool _valid;
+                BarWindow const* _bars;
         };
     }
 }
@@ -0,0 +1,111 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Macd.hpp"
+
+namespace Core
+{
+    namespace Indicator
+    {
+        Macd::Macd(Strategy::Strategy& strategy, unsigned int fastPeriod, unsigned int slowPeriod, unsigned int signalPeriod) :
+            Indicator(strategy, "Macd", 3),
+            _fastPeriod(this->_CheckPeriod(fastPeriod)),
+            _slowPeriod(this->_CheckPeriod(slowPeriod)),
+            _signalPeriod(this->_CheckPeriod(signalPeriod)),
+            _fastEma(this->_fastPeriod, 2.0 / (this->_fastPeriod + 1)),
+            _slowEma(this->_slowPeriod, 2.0 / (this->_slowPeriod + 1)),
+            _signalEma(this->_signalPeriod, 2.0 / (this->_signalPeriod + 1)),
+            _main(0)
+        {
+        }
+
+        void Macd::NotifyBarAdded(Bar const& bar)
+        {
+            this->_fastEma.Add(bar.c);
+            this->_slowEma.Add(bar.c);
+            if (this->_fastEma.IsReady() && this->_slowEma.IsReady())
+            {
+                this->_main = this->_fastEma.GetValue() - this->_slowEma.GetValue();
+                this->_signalEma.Add(this->_main);
+            }
+        }
+
+        void Macd::NotifyBarsCleared()
+        {
+            this->_fastEma.Clear();
+            this->_slowEma.Clear();
+            this->_signalEma.Clear();
+            this->_main = 0;
+            this->_SetValidity(false);
+        }
+
+        void Macd::Run()
+        {
+            this->_SetValidity(this->_signalEma.IsReady());
+            if (!this->IsValid())
+                return;
+            this->_SetOutput(OutputMain, this->_main);
+            this->_SetOutput(OutputSignal, this->_signalEma.GetValue());
+            this->_SetOutput(OutputHistogram, this->_main - this->_signalEma.GetValue());
+        }
+
+        unsigned int Macd::ComputeSeries(std::vector<float> const& closes, unsigned int fastPeriod, unsigned int slowPeriod, unsigned int signalPeriod,
+                std::vector<float>& main, std::vector<float>& signal, std::vector<float>& histogram)
+        {
+            unsigned int size = closes.size();
+            fastPeriod = fastPeriod ? fastPeriod : 1;
+            slowPeriod = slowPeriod ? slowPeriod : 1;
+            signalPeriod = signalPeriod ? signalPeriod : 1;
+            main.assign(size, 0);
+            signal.assign(size, 0);
+            histogram.assign(size, 0);
+            ExpSmoothing fastEma(fastPeriod, 2.0 / (fastPeriod + 1));
+            ExpSmoothing slowEma(slowPeriod, 2.0 / (slowPeriod + 1));
+            ExpSmoothing signalEma(signalPeriod, 2.0 / (signalPeriod + 1));
+            unsigned int firstValid = size;
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                fastEma.Add(closes[i]);
+                slowEma.Add(closes[i]);
+                if (!fastEma.IsReady() || !slowEma.IsReady())
+                    continue;
+                double value = fastEma.GetValue() - slowEma.GetValue();
+                signalEma.Add(value);
+                if (!signalEma.IsReady())
+                    continue;
+                if (firstValid == size)
+                    firstValid = i;
+                main[i] = value;
+                signal[i] = signalEma.GetValue();
+                histogram[i] = value - signalEma.GetValue();
+            }
+            return firstValid;
+        }
+    }
+}
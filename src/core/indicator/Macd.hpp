@@ -0,0 +1,72 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __CORE_INDICATOR_MACD__
+#define __CORE_INDICATOR_MACD__
+
+#include "Indicator.hpp"
+#include "Streaming.hpp"
+
+namespace Core
+{
+    namespace Indicator
+    {
+        /*
+         * Moving average convergence/divergence: exponential moving average of the closes of fastPeriod
+         * minus the one of slowPeriod, its signal line (exponential moving average of signalPeriod) and their difference.
+         */
+        class Macd :
+            public Indicator
+        {
+            public:
+                enum
+                {
+                    OutputMain = 0,
+                    OutputSignal = 1,
+                    OutputHistogram = 2,
+                };
+                explicit Macd(Strategy::Strategy& strategy, unsigned int fastPeriod, unsigned int slowPeriod, unsigned int signalPeriod);
+                virtual void Run();
+                virtual void NotifyBarAdded(Bar const& bar);
+                virtual void NotifyBarsCleared();
+                static unsigned int ComputeSeries(std::vector<float> const& closes, unsigned int fastPeriod, unsigned int slowPeriod, unsigned int signalPeriod,
+                        std::vector<float>& main, std::vector<float>& signal, std::vector<float>& histogram);
+            private:
+                unsigned int _fastPeriod;
+                unsigned int _slowPeriod;
+                unsigned int _signalPeriod;
+                ExpSmoothing _fastEma;
+                ExpSmoothing _slowEma;
+                ExpSmoothing _signalEma;
+                double _main;
+        };
+    }
+}
+
+#endif
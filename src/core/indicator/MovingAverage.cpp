@@ -40,39 +40,70 @@ namespace Core
     {
         MovingAverage::MovingAverage(Strategy::Strategy& strategy, unsigned int period, StratParams& stratParams) :
             Indicator(strategy, "MovingAverage", 1),
-            _period(period),
-            _debug(stratParams.GetString("maDebug", "normal") == "debug")
+            _debugSlot(stratParams.DeclareString("maDebug", "normal")),
+            _debug(stratParams.GetStringSlot(this->_debugSlot) == "debug"),
+            _period(this->_CheckWindowPeriod(period, 2)),
+            _sum(0)
         {
-            if (this->_period < 2)
-            {
-                this->Log(CLASS "Invalid period of " + Tools::ToString(this->_period) + ", chaging to 2.", Logger::Warning);
-                this->_period = 2;
-            }
+        }
+
+        void MovingAverage::Reset(unsigned int period, StratParams& stratParams)
+        {
+            this->_period = this->_CheckWindowPeriod(period, 2);
+            this->_debug = stratParams.GetStringSlot(this->_debugSlot) == "debug";
+            BarWindow const& bars = this->GetBars();
+            this->_sum = 0;
+            for (unsigned int i = 0; i < this->_period && i < bars.GetSize(); ++i)
+                this->_sum += bars[i].c;
+            this->_SetValidity(false);
+        }
+
+        void MovingAverage::NotifyBarAdded(Bar const& bar)
+        {
+            BarWindow const& bars = this->GetBars();
+            this->_sum += bar.c;
+            if (bars.GetSize() > this->_period)
+                this->_sum -= bars[this->_period].c;
+        }
+
+        void MovingAverage::NotifyBarsCleared()
+        {
+            this->_sum = 0;
+            this->_SetValidity(false);
         }
 
         void MovingAverage::Run()
         {
-            std::list<Bar> const& bars = this->GetBars();
-            if (bars.size() >= this->_period)
+            BarWindow const& bars = this->GetBars();
+            if (bars.GetSize() >= this->_period)
             {
-                float total = 0;
-                unsigned int i = 0;
-                std::list<Bar>::const_iterator it = bars.begin();
-                while (i < this->_period)
-                {
-                    if (this->_debug)
-                        this->Log(CLASS "MA (" + Tools::ToString(this->_period) + ") value " + Tools::ToString(i + 1) + ": " + Tools::ToString(it->c, this->GetStrategy().GetDigits()));
-                    total += it->c;
-                    ++i;
-                    ++it;
-                }
+                if (this->_debug)
+                    for (unsigned int i = 0; i < this->_period; ++i)
+                        this->Log(CLASS "MA (" + Tools::ToString(this->_period) + ") value " + Tools::ToString(i + 1) + ": " + Tools::ToString(bars[i].c, this->GetStrategy().GetDigits()));
                 this->_SetValidity(true);
-                this->_SetOutput(OutputMovingAverage, total / this->_period);
+                this->_SetOutput(OutputMovingAverage, this->_sum / this->_period);
             }
             else
                 this->_SetValidity(false);
         }
 
+        unsigned int MovingAverage::ComputeSeries(std::vector<float> const& closes, unsigned int period, std::vector<float>& output)
+        {
+            unsigned int size = closes.size();
+            if (period < 2)
+                period = 2;
+            output.assign(size, 0);
+            if (size < period)
+                return size;
+            std::vector<double> sums(size + 1);
+            sums[0] = 0;
+            for (unsigned int i = 0; i < size; ++i)
+                sums[i + 1] = sums[i] + closes[i];
+            for (unsigned int i = period - 1; i < size; ++i)
+                output[i] = (sums[i + 1] - sums[i + 1 - period]) / period;
+            return period - 1;
+        }
+
         unsigned int MovingAverage::GetPeriod() const
         {
             return this->_period;
@@ -48,10 +48,29 @@ namespace Core
                 };
                 explicit MovingAverage(Strategy::Strategy& strategy, unsigned int period, StratParams& stratParams);
                 virtual void Run();
+
+                /*
+                   The sum of the closes of the window is updated with every bar added (see Signal::_RegisterIndicator()),
+                   so Run() does not depend on the period.
+                */
+                virtual void NotifyBarAdded(Bar const& bar);
+                virtual void NotifyBarsCleared();
                 unsigned int GetPeriod() const;
+
+                /*
+                   Changes the period and reads the parameters again without reallocating, the output is invalidated.
+                */
+                void Reset(unsigned int period, StratParams& stratParams);
+
+                /*
+                   From the differences of the prefix sums of the closes (see Indicator::GetColumn()).
+                */
+                static unsigned int ComputeSeries(std::vector<float> const& closes, unsigned int period, std::vector<float>& output);
             private:
-                unsigned int _period;
+                unsigned int _debugSlot;
                 bool _debug;
+                unsigned int _period;
+                double _sum; // of the closes of the last _period bars
         };
     }
 }
@@ -0,0 +1,100 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "RelativeStrengthIndex.hpp"
+
+namespace Core
+{
+    namespace Indicator
+    {
+        RelativeStrengthIndex::RelativeStrengthIndex(Strategy::Strategy& strategy, unsigned int period) :
+            Indicator(strategy, "RelativeStrengthIndex", 1),
+            _period(this->_CheckPeriod(period)),
+            _gains(this->_period, 1.0 / this->_period),
+            _losses(this->_period, 1.0 / this->_period)
+        {
+        }
+
+        void RelativeStrengthIndex::NotifyBarAdded(Bar const& bar)
+        {
+            BarWindow const& bars = this->GetBars();
+            if (bars.GetSize() < 2)
+                return;
+            float change = bar.c - bars[1].c;
+            this->_gains.Add(change > 0 ? change : 0);
+            this->_losses.Add(change < 0 ? -change : 0);
+        }
+
+        void RelativeStrengthIndex::NotifyBarsCleared()
+        {
+            this->_gains.Clear();
+            this->_losses.Clear();
+            this->_SetValidity(false);
+        }
+
+        void RelativeStrengthIndex::Run()
+        {
+            this->_SetValidity(this->_gains.IsReady());
+            if (!this->IsValid())
+                return;
+            this->_SetOutput(OutputRsi, _GetRsi(this->_gains.GetValue(), this->_losses.GetValue()));
+        }
+
+        float RelativeStrengthIndex::_GetRsi(double gain, double loss)
+        {
+            if (loss > 0)
+                return 100 - 100 / (1 + gain / loss);
+            return gain > 0 ? 100 : 50;
+        }
+
+        unsigned int RelativeStrengthIndex::ComputeSeries(std::vector<float> const& closes, unsigned int period, std::vector<float>& output)
+        {
+            unsigned int size = closes.size();
+            if (!period)
+                period = 1;
+            output.assign(size, 0);
+            ExpSmoothing gains(period, 1.0 / period);
+            ExpSmoothing losses(period, 1.0 / period);
+            for (unsigned int i = 1; i < size; ++i)
+            {
+                float change = closes[i] - closes[i - 1];
+                gains.Add(change > 0 ? change : 0);
+                losses.Add(change < 0 ? -change : 0);
+                if (gains.IsReady())
+                    output[i] = _GetRsi(gains.GetValue(), losses.GetValue());
+            }
+            return size <= period ? size : period;
+        }
+
+        unsigned int RelativeStrengthIndex::GetPeriod() const
+        {
+            return this->_period;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __CORE_INDICATOR_RELATIVESTRENGTHINDEX__
+#define __CORE_INDICATOR_RELATIVESTRENGTHINDEX__
+
+#include "Indicator.hpp"
+#include "Streaming.hpp"
+
+namespace Core
+{
+    namespace Indicator
+    {
+        /*
+         * Relative strength index (0 to 100) of the closes, with Wilder's smoothing of the gains and losses.
+         * Valid after period + 1 bars.
+         */
+        class RelativeStrengthIndex :
+            public Indicator
+        {
+            public:
+                enum
+                {
+                    OutputRsi = 0,
+                };
+                explicit RelativeStrengthIndex(Strategy::Strategy& strategy, unsigned int period);
+                virtual void Run();
+                virtual void NotifyBarAdded(Bar const& bar);
+                virtual void NotifyBarsCleared();
+                unsigned int GetPeriod() const;
+                static unsigned int ComputeSeries(std::vector<float> const& closes, unsigned int period, std::vector<float>& output);
+            private:
+                static float _GetRsi(double gain, double loss);
+                unsigned int _period;
+                ExpSmoothing _gains;
+                ExpSmoothing _losses;
+        };
+    }
+}
+
+#endif
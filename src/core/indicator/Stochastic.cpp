@@ -0,0 +1,124 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "Stochastic.hpp"
+
+namespace Core
+{
+    namespace Indicator
+    {
+        Stochastic::Stochastic(Strategy::Strategy& strategy, unsigned int kPeriod, unsigned int dPeriod, unsigned int slowing) :
+            Indicator(strategy, "Stochastic", 2),
+            _kPeriod(this->_CheckPeriod(kPeriod)),
+            _dPeriod(this->_CheckPeriod(dPeriod)),
+            _slowing(this->_CheckPeriod(slowing)),
+            _lowest(this->_kPeriod, false),
+            _highest(this->_kPeriod, true),
+            _numerator(this->_slowing),
+            _denominator(this->_slowing),
+            _main(this->_dPeriod),
+            _lastMain(0)
+        {
+        }
+
+        void Stochastic::NotifyBarAdded(Bar const& bar)
+        {
+            this->_lowest.Add(bar.l);
+            this->_highest.Add(bar.h);
+            if (!this->_lowest.IsFull())
+                return;
+            float lowest = this->_lowest.GetValue();
+            this->_numerator.Add(bar.c - lowest);
+            this->_denominator.Add(this->_highest.GetValue() - lowest);
+            if (!this->_numerator.IsFull())
+                return;
+            double denominator = this->_denominator.GetSum();
+            this->_lastMain = denominator > 0 ? 100 * this->_numerator.GetSum() / denominator : 100;
+            this->_main.Add(this->_lastMain);
+        }
+
+        void Stochastic::NotifyBarsCleared()
+        {
+            this->_lowest.Clear();
+            this->_highest.Clear();
+            this->_numerator.Clear();
+            this->_denominator.Clear();
+            this->_main.Clear();
+            this->_lastMain = 0;
+            this->_SetValidity(false);
+        }
+
+        void Stochastic::Run()
+        {
+            this->_SetValidity(this->_main.IsFull());
+            if (!this->IsValid())
+                return;
+            this->_SetOutput(OutputMain, this->_lastMain);
+            this->_SetOutput(OutputSignal, this->_main.GetSum() / this->_dPeriod);
+        }
+
+        unsigned int Stochastic::ComputeSeries(std::vector<float> const& highs, std::vector<float> const& lows, std::vector<float> const& closes,
+                unsigned int kPeriod, unsigned int dPeriod, unsigned int slowing,
+                std::vector<float>& main, std::vector<float>& signal)
+        {
+            unsigned int size = closes.size();
+            kPeriod = kPeriod ? kPeriod : 1;
+            dPeriod = dPeriod ? dPeriod : 1;
+            slowing = slowing ? slowing : 1;
+            main.assign(size, 0);
+            signal.assign(size, 0);
+            if (highs.size() != size || lows.size() != size)
+                return size;
+            std::vector<float> lowest;
+            std::vector<float> highest;
+            RollingExtremum::ComputeSeries(lows, kPeriod, false, lowest);
+            RollingExtremum::ComputeSeries(highs, kPeriod, true, highest);
+            RollingSum numerator(slowing);
+            RollingSum denominator(slowing);
+            RollingSum mainSum(dPeriod);
+            unsigned int firstValid = size;
+            for (unsigned int i = kPeriod - 1; i < size; ++i)
+            {
+                numerator.Add(closes[i] - lowest[i]);
+                denominator.Add(highest[i] - lowest[i]);
+                if (!numerator.IsFull())
+                    continue;
+                double value = denominator.GetSum() > 0 ? 100 * numerator.GetSum() / denominator.GetSum() : 100;
+                mainSum.Add(value);
+                if (!mainSum.IsFull())
+                    continue;
+                if (firstValid == size)
+                    firstValid = i;
+                main[i] = value;
+                signal[i] = mainSum.GetSum() / dPeriod;
+            }
+            return firstValid;
+        }
+    }
+}
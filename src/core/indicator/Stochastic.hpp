@@ -0,0 +1,81 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __CORE_INDICATOR_STOCHASTIC__
+#define __CORE_INDICATOR_STOCHASTIC__
+
+#include "Indicator.hpp"
+#include "Streaming.hpp"
+
+namespace Core
+{
+    namespace Indicator
+    {
+        /*
+         * Stochastic oscillator (0 to 100).
+         * Main line: sum of (close - lowest low) over sum of (highest high - lowest low) of the last slowing bars,
+         * the lowest low and highest high being taken over kPeriod bars.
+         * Signal line: simple moving average of dPeriod main values.
+         */
+        class Stochastic :
+            public Indicator
+        {
+            public:
+                enum
+                {
+                    OutputMain = 0,
+                    OutputSignal = 1,
+                };
+                explicit Stochastic(Strategy::Strategy& strategy, unsigned int kPeriod, unsigned int dPeriod, unsigned int slowing);
+                virtual void Run();
+                virtual void NotifyBarAdded(Bar const& bar);
+                virtual void NotifyBarsCleared();
+
+                /*
+                   The lowest lows and highest highs are computed with RollingExtremum::ComputeSeries().
+                   There is no valid output if highs, lows and closes do not have the same size.
+                */
+                static unsigned int ComputeSeries(std::vector<float> const& highs, std::vector<float> const& lows, std::vector<float> const& closes,
+                        unsigned int kPeriod, unsigned int dPeriod, unsigned int slowing,
+                        std::vector<float>& main, std::vector<float>& signal);
+            private:
+                unsigned int _kPeriod;
+                unsigned int _dPeriod;
+                unsigned int _slowing;
+                RollingExtremum _lowest;
+                RollingExtremum _highest;
+                RollingSum _numerator;
+                RollingSum _denominator;
+                RollingSum _main;
+                double _lastMain;
+        };
+    }
+}
+
+#endif
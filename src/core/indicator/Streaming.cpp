@@ -0,0 +1,180 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include "Streaming.hpp"
+
+namespace Core
+{
+    namespace Indicator
+    {
+        ExpSmoothing::ExpSmoothing(unsigned int period, double alpha) :
+            _period(period ? period : 1), _alpha(alpha)
+        {
+            this->Clear();
+        }
+
+        void ExpSmoothing::Add(double value)
+        {
+            if (this->_count < this->_period)
+            {
+                // simple average of the first values
+                ++this->_count;
+                this->_value += (value - this->_value) / this->_count;
+            }
+            else
+                this->_value += this->_alpha * (value - this->_value);
+        }
+
+        void ExpSmoothing::Clear()
+        {
+            this->_count = 0;
+            this->_value = 0;
+        }
+
+        bool ExpSmoothing::IsReady() const
+        {
+            return this->_count == this->_period;
+        }
+
+        double ExpSmoothing::GetValue() const
+        {
+            return this->_value;
+        }
+
+        RollingSum::RollingSum(unsigned int period) :
+            _values(period ? period : 1)
+        {
+            this->Clear();
+        }
+
+        void RollingSum::Add(double value)
+        {
+            if (this->_count == this->_values.size())
+                this->_sum -= this->_values[this->_next];
+            else
+                ++this->_count;
+            this->_values[this->_next] = value;
+            this->_sum += value;
+            if (++this->_next == this->_values.size())
+                this->_next = 0;
+        }
+
+        void RollingSum::Clear()
+        {
+            this->_next = 0;
+            this->_count = 0;
+            this->_sum = 0;
+        }
+
+        bool RollingSum::IsFull() const
+        {
+            return this->_count == this->_values.size();
+        }
+
+        double RollingSum::GetSum() const
+        {
+            return this->_sum;
+        }
+
+        RollingExtremum::RollingExtremum(unsigned int period, bool maximum) :
+            _queue(period ? period : 1), _maximum(maximum)
+        {
+            this->Clear();
+        }
+
+        void RollingExtremum::Add(float value)
+        {
+            unsigned int capacity = this->_queue.size();
+            // the value at the head leaves the window
+            if (this->_size && this->_queue[this->_head].index + capacity <= this->_index)
+            {
+                if (++this->_head == capacity)
+                    this->_head = 0;
+                --this->_size;
+            }
+            // values that can no longer be the extremum
+            while (this->_size)
+            {
+                Entry const& newest = this->_queue[(this->_head + this->_size - 1) % capacity];
+                if (this->_maximum ? newest.value > value : newest.value < value)
+                    break;
+                --this->_size;
+            }
+            Entry& entry = this->_queue[(this->_head + this->_size) % capacity];
+            entry.index = this->_index;
+            entry.value = value;
+            ++this->_size;
+            ++this->_index;
+        }
+
+        void RollingExtremum::Clear()
+        {
+            this->_head = 0;
+            this->_size = 0;
+            this->_index = 0;
+        }
+
+        bool RollingExtremum::IsFull() const
+        {
+            return this->_index >= this->_queue.size();
+        }
+
+        float RollingExtremum::GetValue() const
+        {
+            return this->_size ? this->_queue[this->_head].value : 0;
+        }
+
+        void RollingExtremum::ComputeSeries(std::vector<float> const& values, unsigned int period, bool maximum, std::vector<float>& output)
+        {
+            unsigned int size = values.size();
+            if (!period)
+                period = 1;
+            output.assign(size, 0);
+            if (size < period)
+                return;
+            // within blocks of period values: extremum from the start of the block (forward) and to its end (backward)
+            std::vector<float> forward(size);
+            std::vector<float> backward(size);
+            for (unsigned int i = 0; i < size; ++i)
+                forward[i] = i % period == 0 ? values[i] :
+                    maximum ? std::max(forward[i - 1], values[i]) : std::min(forward[i - 1], values[i]);
+            for (unsigned int i = size; i > 0; --i)
+                backward[i - 1] = i == size || i % period == 0 ? values[i - 1] :
+                    maximum ? std::max(backward[i], values[i - 1]) : std::min(backward[i], values[i - 1]);
+            // a window spans the end of a block and the start of the next one
+            if (maximum)
+                for (unsigned int i = period - 1; i < size; ++i)
+                    output[i] = std::max(backward[i + 1 - period], forward[i]);
+            else
+                for (unsigned int i = period - 1; i < size; ++i)
+                    output[i] = std::min(backward[i + 1 - period], forward[i]);
+        }
+    }
+}
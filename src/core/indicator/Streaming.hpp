@@ -0,0 +1,116 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __CORE_INDICATOR_STREAMING__
+#define __CORE_INDICATOR_STREAMING__
+
+#include <boost/noncopyable.hpp>
+#include <vector>
+
+/*
+   Building blocks of the incremental indicators: each value is added in constant (or amortized constant) time.
+*/
+
+namespace Core
+{
+    namespace Indicator
+    {
+        /*
+           Exponential smoothing of a series, seeded with the simple average of its first period values.
+           alpha is 2 / (period + 1) for an exponential moving average, 1 / period for Wilder's smoothing.
+        */
+        class ExpSmoothing :
+            private boost::noncopyable
+        {
+            public:
+                explicit ExpSmoothing(unsigned int period, double alpha);
+                void Add(double value);
+                void Clear();
+                bool IsReady() const;
+                double GetValue() const;
+            private:
+                unsigned int _period;
+                double _alpha;
+                unsigned int _count;
+                double _value;
+        };
+
+        /*
+           Sum of the last period values of a series.
+        */
+        class RollingSum :
+            private boost::noncopyable
+        {
+            public:
+                explicit RollingSum(unsigned int period);
+                void Add(double value);
+                void Clear();
+                bool IsFull() const;
+                double GetSum() const;
+            private:
+                std::vector<double> _values; // circular, the oldest value is at _next when full
+                unsigned int _next;
+                unsigned int _count;
+                double _sum;
+        };
+
+        /*
+           Minimum or maximum of the last period values of a series, kept with a monotonic queue.
+        */
+        class RollingExtremum :
+            private boost::noncopyable
+        {
+            public:
+                explicit RollingExtremum(unsigned int period, bool maximum);
+                void Add(float value);
+                void Clear();
+                bool IsFull() const;
+                float GetValue() const;
+
+                /*
+                   Extremum of each window of period values ending at output[i] (for i >= period - 1, 0 before),
+                   with the van Herk/Gil-Werman algorithm: about 3 comparisons per value, whatever the period.
+                */
+                static void ComputeSeries(std::vector<float> const& values, unsigned int period, bool maximum, std::vector<float>& output);
+            private:
+                struct Entry
+                {
+                    unsigned int index;
+                    float value;
+                };
+                std::vector<Entry> _queue; // circular, values are monotonic from _head (the extremum) to the newest one
+                unsigned int _head;
+                unsigned int _size;
+                unsigned int _index; // number of values added
+                bool _maximum;
+        };
+    }
+}
+
+#endif
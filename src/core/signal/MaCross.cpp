@@ -39,16 +39,40 @@ namespace Core
     namespace Signal
     {
         MaCross::MaCross(Strategy::Strategy& strategy, StratParams& stratParams) :
-            Signal(strategy, "MaCross", stratParams.GetFloat("macSlowMa", 100), false),
-            _fastMa(strategy, stratParams.GetFloat("macFastMa", 20), stratParams),
-            _slowMa(strategy, stratParams.GetFloat("macSlowMa", 100), stratParams),
-            _prevFastMa(-1),
-            _prevSlowMa(-1),
-            _lots(stratParams.GetFloat("macLots", 0.01)),
-            _sl(stratParams.GetFloat("macSl", 10)),
-            _tp(stratParams.GetFloat("macTp", 10)),
-            _debug(stratParams.GetString("macDebug", "normal") == "debug")
+            Signal(strategy, "MaCross", 0, false),
+            _slowMaSlot(stratParams.DeclareFloat("macSlowMa", 100)),
+            _fastMaSlot(stratParams.DeclareFloat("macFastMa", 20)),
+            _lotsSlot(stratParams.DeclareFloat("macLots", 0.01)),
+            _slSlot(stratParams.DeclareFloat("macSl", 10)),
+            _tpSlot(stratParams.DeclareFloat("macTp", 10)),
+            _debugSlot(stratParams.DeclareString("macDebug", "normal")),
+            _fastMa(strategy, stratParams.GetFloatSlot(this->_fastMaSlot), stratParams),
+            _slowMa(strategy, stratParams.GetFloatSlot(this->_slowMaSlot), stratParams)
         {
+            this->_RegisterIndicator(this->_fastMa);
+            this->_RegisterIndicator(this->_slowMa);
+            this->_ReadParams(stratParams);
+        }
+
+        void MaCross::Reset(StratParams& stratParams)
+        {
+            Signal::Reset(stratParams);
+            this->_ReadParams(stratParams);
+        }
+
+        void MaCross::_ReadParams(StratParams& stratParams)
+        {
+            unsigned int fastPeriod = stratParams.GetFloatSlot(this->_fastMaSlot);
+            unsigned int slowPeriod = stratParams.GetFloatSlot(this->_slowMaSlot);
+            this->_SetMinBars(slowPeriod);
+            this->_fastMa.Reset(fastPeriod, stratParams);
+            this->_slowMa.Reset(slowPeriod, stratParams);
+            this->_prevFastMa = -1;
+            this->_prevSlowMa = -1;
+            this->_lots = stratParams.GetFloatSlot(this->_lotsSlot);
+            this->_sl = stratParams.GetFloatSlot(this->_slSlot);
+            this->_tp = stratParams.GetFloatSlot(this->_tpSlot);
+            this->_debug = stratParams.GetStringSlot(this->_debugSlot) == "debug";
         }
 
         void MaCross::Run(Controller::Output& output, Bar const&, float ask, float bid, bool)
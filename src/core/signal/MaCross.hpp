@@ -39,14 +39,22 @@ namespace Core
 
     namespace Signal
     {
-        class MaCross :
+        class MaCross final :
             public Signal
         {
             public:
                 explicit MaCross(Strategy::Strategy& strategy, StratParams& stratParams);
                 virtual void Run(Controller::Output& output, Bar const& currentBar, float ask, float bid, bool newBar);
                 virtual void NotifyTradeStop();
+                virtual void Reset(StratParams& stratParams);
             private:
+                void _ReadParams(StratParams& stratParams);
+                unsigned int _slowMaSlot;
+                unsigned int _fastMaSlot;
+                unsigned int _lotsSlot;
+                unsigned int _slSlot;
+                unsigned int _tpSlot;
+                unsigned int _debugSlot;
                 Indicator::MovingAverage _fastMa;
                 Indicator::MovingAverage _slowMa;
                 float _prevFastMa;
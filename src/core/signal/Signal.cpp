@@ -29,6 +29,8 @@
 
 #include "Signal.hpp"
 #include "core/strategy/Strategy.hpp"
+#include "core/indicator/Indicator.hpp"
+#include "tools/ToString.hpp"
 
 #define CLASS "[Core/Signal/Signal] "
 
@@ -37,13 +39,17 @@ namespace Core
     namespace Signal
     {
         Signal::Signal(Strategy::Strategy& strategy, std::string const& name, unsigned int minBars, bool triggerOnTick) :
-            _strategy(strategy), _name(name), _minBars(minBars), _triggerOnTick(triggerOnTick)
+            _strategy(strategy), _name(name), _minBars(minBars), _triggerOnTick(triggerOnTick), _bars(MaxBars)
         {
             this->_strategy.Log(CLASS "Signal \"" + this->_name + "\" instantiated.");
         }
 
         Signal::~Signal()
         {
+            std::vector<Timeframe*>::iterator it = this->_timeframes.begin();
+            std::vector<Timeframe*>::iterator itEnd = this->_timeframes.end();
+            for (; it != itEnd; ++it)
+                delete *it;
             this->_strategy.Log(CLASS "Signal \"" + this->_name + "\" destroyed.");
         }
 
@@ -67,16 +73,134 @@ namespace Core
         {
         }
 
+        void Signal::Reset(StratParams&)
+        {
+            this->ClearBars();
+        }
+
+        void Signal::_SetMinBars(unsigned int minBars)
+        {
+            this->_minBars = minBars;
+        }
+
+        Signal::Timeframe::Timeframe(unsigned int period) :
+            period(period), interval(0), open(false), bars(MaxBars)
+        {
+        }
+
+        void Signal::_SubscribePeriod(unsigned int period)
+        {
+            unsigned int strategyPeriod = this->_strategy.GetPeriod();
+            unsigned int nbBarsPerBar = (period + strategyPeriod / 2) / strategyPeriod;
+            if (nbBarsPerBar * strategyPeriod != period)
+                this->Log(CLASS "Period " + Tools::ToString(period) + " is not a multiple of the strategy period " + Tools::ToString(strategyPeriod) + ", using " + Tools::ToString(nbBarsPerBar > 1 ? nbBarsPerBar * strategyPeriod : strategyPeriod) + ".", Logger::Warning);
+            if (nbBarsPerBar <= 1 || this->_GetTimeframe(period))
+                return;
+            this->_timeframes.push_back(new Timeframe(nbBarsPerBar * strategyPeriod));
+        }
+
+        Signal::Timeframe* Signal::_GetTimeframe(unsigned int period) const
+        {
+            unsigned int strategyPeriod = this->_strategy.GetPeriod();
+            period = (period + strategyPeriod / 2) / strategyPeriod * strategyPeriod;
+            std::vector<Timeframe*>::const_iterator it = this->_timeframes.begin();
+            std::vector<Timeframe*>::const_iterator itEnd = this->_timeframes.end();
+            for (; it != itEnd; ++it)
+                if ((*it)->period == period)
+                    return *it;
+            return 0;
+        }
+
+        void Signal::_RegisterIndicator(Indicator::Indicator& indicator, unsigned int period /* = 0 */)
+        {
+            Timeframe* timeframe = period ? this->_GetTimeframe(period) : 0;
+            if (period && !timeframe)
+            {
+                this->_SubscribePeriod(period);
+                timeframe = this->_GetTimeframe(period);
+            }
+            if (timeframe)
+            {
+                indicator.SetBars(timeframe->bars);
+                timeframe->indicators.push_back(&indicator);
+            }
+            else
+            {
+                indicator.SetBars(this->_bars);
+                this->_indicators.push_back(&indicator);
+            }
+        }
+
+        void Signal::_NotifyBarAdded(std::vector<Indicator::Indicator*>& indicators, Bar const& bar)
+        {
+            std::vector<Indicator::Indicator*>::iterator it = indicators.begin();
+            std::vector<Indicator::Indicator*>::iterator itEnd = indicators.end();
+            for (; it != itEnd; ++it)
+                (*it)->NotifyBarAdded(bar);
+        }
+
+        void Signal::_NotifyBarsCleared(std::vector<Indicator::Indicator*>& indicators)
+        {
+            std::vector<Indicator::Indicator*>::iterator it = indicators.begin();
+            std::vector<Indicator::Indicator*>::iterator itEnd = indicators.end();
+            for (; it != itEnd; ++it)
+                (*it)->NotifyBarsCleared();
+        }
+
         void Signal::ClearBars()
         {
-            this->_bars.clear();
+            this->_bars.Clear();
+            Signal::_NotifyBarsCleared(this->_indicators);
+            std::vector<Timeframe*>::iterator it = this->_timeframes.begin();
+            std::vector<Timeframe*>::iterator itEnd = this->_timeframes.end();
+            for (; it != itEnd; ++it)
+            {
+                (*it)->open = false;
+                (*it)->bars.Clear();
+                Signal::_NotifyBarsCleared((*it)->indicators);
+            }
         }
 
         void Signal::AddBar(Bar const& bar)
         {
-            this->_bars.push_front(bar);
-            if (this->_bars.size() > MaxBars)
-                this->_bars.pop_back();
+            this->_bars.Push(bar);
+            Signal::_NotifyBarAdded(this->_indicators, bar);
+            time_t strategySecs = this->_strategy.GetPeriod() * 60;
+            std::vector<Timeframe*>::iterator it = this->_timeframes.begin();
+            std::vector<Timeframe*>::iterator itEnd = this->_timeframes.end();
+            for (; it != itEnd; ++it)
+            {
+                Timeframe& timeframe = **it;
+                time_t secs = timeframe.period * 60;
+                time_t interval = bar.time / secs;
+                if (timeframe.open && interval != timeframe.interval) // the end of the previous interval is missing
+                {
+                    timeframe.open = false;
+                    timeframe.bars.Push(timeframe.current);
+                    Signal::_NotifyBarAdded(timeframe.indicators, timeframe.current);
+                }
+                if (!timeframe.open)
+                {
+                    timeframe.current = bar;
+                    timeframe.current.time = interval * secs;
+                    timeframe.interval = interval;
+                    timeframe.open = true;
+                }
+                else
+                {
+                    if (bar.h > timeframe.current.h)
+                        timeframe.current.h = bar.h;
+                    if (bar.l < timeframe.current.l)
+                        timeframe.current.l = bar.l;
+                    timeframe.current.c = bar.c;
+                }
+                if ((bar.time + strategySecs) / secs != interval) // last bar of the interval
+                {
+                    timeframe.open = false;
+                    timeframe.bars.Push(timeframe.current);
+                    Signal::_NotifyBarAdded(timeframe.indicators, timeframe.current);
+                }
+            }
         }
 
         std::string const& Signal::GetName() const
@@ -94,11 +218,17 @@ namespace Core
             return this->_triggerOnTick;
         }
 
-        std::list<Bar> const& Signal::GetBars() const
+        BarWindow const& Signal::GetBars() const
         {
             return this->_bars;
         }
 
+        BarWindow const& Signal::GetBars(unsigned int period) const
+        {
+            Timeframe* timeframe = this->_GetTimeframe(period);
+            return timeframe ? timeframe->bars : this->_bars;
+        }
+
         Strategy::Strategy& Signal::GetStrategy()
         {
             return this->_strategy;
@@ -31,18 +31,30 @@
 #define __CORE_SIGNAL_SIGNAL__
 
 #include <boost/noncopyable.hpp>
-#include <list>
+#include <vector>
 #include "core/Controller.hpp"
+#include "core/BarWindow.hpp"
 #include "logger/Logger.hpp"
 
 namespace Core
 {
+    class StratParams;
+
+    namespace Indicator
+    {
+        class Indicator;
+    }
+
     namespace Signal
     {
         class Signal :
             private boost::noncopyable
         {
             public:
+                enum
+                {
+                    MaxBars = 2880, // 2 days in 1 minute bars, capacity of the bar windows of every period
+                };
                 explicit Signal(Strategy::Strategy& strategy, std::string const& name, unsigned int minBars, bool triggerOnTick);
                 virtual ~Signal();
 
@@ -50,7 +62,7 @@ namespace Core
                    Process the added bars to produce a signal.
                    The result is given by modifying the controller output.
                    The last OHLC given by the client is currentBar.
-                   The last completed bar of the strategy's period is at the front of _bars.
+                   The last completed bar of the strategy's period is GetBars()[0].
                    Called when a new bar is added, or on every tick if triggerOnTick was set.
                  */
                 virtual void Run(Controller::Output& output, Bar const& currentBar, float ask, float bid, bool newBar) = 0;
@@ -65,24 +77,66 @@ namespace Core
                 virtual void NotifyTradeTpUpdate(float tp);
                 virtual void NotifyTradeStop();
 
+                /*
+                   Called when the strategy is reused for another set of parameters (see Strategy::Reset()).
+                   Must read the parameters again and restore the state of a newly constructed signal.
+                   The base implementation clears the bars, the registered indicators are kept.
+                */
+                virtual void Reset(StratParams& stratParams);
+
                 void AddBar(Bar const& bar);
                 void ClearBars();
                 std::string const& GetName() const;
                 unsigned int GetMinBars() const;
                 bool TriggerOnTick() const;
-                std::list<Bar> const& GetBars() const;
+                BarWindow const& GetBars() const;
+
+                /*
+                   Bars of a period subscribed with _SubscribePeriod(), the bars of the strategy's period for any other period.
+                */
+                BarWindow const& GetBars(unsigned int period) const;
                 Strategy::Strategy& GetStrategy();
                 void Log(std::string const& msg, Logger::MessageType type = Logger::Info);
+            protected:
+                void _SetMinBars(unsigned int minBars);
+
+                /*
+                   Adds a period (in minutes) whose bars are built from the bars of the strategy's period, as they are added.
+                   It is rounded to a multiple of the strategy's period: each of its bars is made of the bars whose time falls
+                   in [n * period, (n + 1) * period) (in seconds since the epoch), so that it starts on a period boundary.
+                   A bar is completed by the last bar of its interval, or by the first bar of a later interval after a gap.
+                   The minimum number of bars given to the constructor must include the bars needed by the subscribed periods.
+                   Subscribing twice to a period does nothing. Subscriptions are kept by Reset().
+                */
+                void _SubscribePeriod(unsigned int period);
+
+                /*
+                   The indicator will be notified of every bar added to the given period (0 for the strategy's period,
+                   which is subscribed to automatically) and when the bars are cleared.
+                   It must stay alive as long as the signal.
+                */
+                void _RegisterIndicator(Indicator::Indicator& indicator, unsigned int period = 0);
             private:
-                enum
+                struct Timeframe
                 {
-                    MaxBars = 2880, // 2 days in 1 minute bars
+                    explicit Timeframe(unsigned int period);
+                    unsigned int period;
+                    time_t interval; // of current, time / (period * 60)
+                    bool open; // current has bars and is not completed yet
+                    Bar current;
+                    BarWindow bars;
+                    std::vector<Indicator::Indicator*> indicators;
                 };
+                Timeframe* _GetTimeframe(unsigned int period) const;
+                static void _NotifyBarAdded(std::vector<Indicator::Indicator*>& indicators, Bar const& bar);
+                static void _NotifyBarsCleared(std::vector<Indicator::Indicator*>& indicators);
                 Strategy::Strategy& _strategy;
                 std::string _name;
                 unsigned int _minBars;
                 bool _triggerOnTick;
-                std::list<Bar> _bars;
+                BarWindow _bars;
+                std::vector<Indicator::Indicator*> _indicators;
+                std::vector<Timeframe*> _timeframes;
         };
     }
 }
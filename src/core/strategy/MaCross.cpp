@@ -29,6 +29,9 @@
 
 #include "MaCross.hpp"
 #include "core/StratParams.hpp"
+#include "core/StrategyInstantiator.hpp"
+#include "core/signal/Signal.hpp"
+#include "core/actor/Actor.hpp"
 #include "core/signal/MaCross.hpp"
 #include "core/actor/DoNothing.hpp"
 
@@ -36,6 +39,11 @@ namespace Core
 {
     namespace Strategy
     {
+        namespace
+        {
+            StrategyRegistry::Registrar registrar("MaCross", &CreateStrategy<MaCross>);
+        }
+
         MaCross::MaCross(Logger::Logger const& logger,
                 Feedback& feedback,
                 std::string const& pair,
@@ -54,6 +62,13 @@ namespace Core
             return true;
         }
 
+        bool MaCross::Reset()
+        {
+            this->_signal->Reset(this->_stratParams);
+            this->_actor->Reset(this->_stratParams);
+            return true;
+        }
+
         void MaCross::Deinit()
         {
             delete this->_signal;
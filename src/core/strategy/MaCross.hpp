@@ -50,6 +50,7 @@ namespace Core
                         StratParams& stratParams);
                 virtual bool Init();
                 virtual void Deinit();
+                virtual bool Reset();
             private:
                 StratParams& _stratParams;
         };
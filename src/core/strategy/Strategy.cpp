@@ -96,6 +96,11 @@ namespace Core
             this->Log(CLASS "Strategy \"" + this->_name + "\" destroyed.");
         }
 
+        bool Strategy::Reset()
+        {
+            return false;
+        }
+
         Signal::Signal& Strategy::GetSignal()
         {
             return *this->_signal;
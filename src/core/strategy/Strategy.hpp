@@ -79,6 +79,15 @@ namespace Core
                  */
                 virtual void Deinit() = 0;
 
+                /*
+                   Called by StrategyInstantiator to reuse an initialized strategy for another set of parameters
+                   (same name, pair, period and digits) instead of calling Deinit() and Init() again.
+                   Must read the strategy parameters again and restore the state of a newly initialized strategy.
+                   true -> Success.
+                   false -> Not supported: the strategy is destroyed and instantiated again (base implementation).
+                 */
+                virtual bool Reset();
+
                 Signal::Signal& GetSignal();
                 Actor::Actor& GetActor();
                 std::string const& GetName() const;
@@ -0,0 +1,216 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+#include <boost/cstdlib.hpp>
+#include "tickbench/Logger.hpp"
+#include "tickbench/StratParams.hpp"
+#include "core/Feedback.hpp"
+#include "core/StrategyInstantiator.hpp"
+#include "core/BarWindow.hpp"
+#include "core/signal/Signal.hpp"
+#include "core/indicator/MovingAverage.hpp"
+#include "core/indicator/ExponentialMovingAverage.hpp"
+#include "core/indicator/RelativeStrengthIndex.hpp"
+#include "core/indicator/AverageTrueRange.hpp"
+#include "core/indicator/BollingerBands.hpp"
+#include "core/indicator/Macd.hpp"
+#include "core/indicator/Stochastic.hpp"
+#include "tools/ToString.hpp"
+
+namespace
+{
+    unsigned int const NbBars = 20000;
+
+    /*
+       An indicator fed bar by bar, and the series computed by its ComputeSeries() (one per output).
+    */
+    struct Check
+    {
+        std::string name;
+        Core::Indicator::Indicator* indicator;
+        unsigned int firstValid;
+        std::vector<std::vector<float> > series;
+        unsigned int nbMismatches;
+    };
+
+    Check& AddCheck(std::vector<Check>& checks, std::string const& name, Core::Indicator::Indicator* indicator)
+    {
+        Check check;
+        check.name = name;
+        check.indicator = indicator;
+        check.firstValid = 0;
+        check.series.resize(indicator->GetNbOutputs());
+        check.nbMismatches = 0;
+        checks.push_back(check);
+        return checks.back();
+    }
+
+    /*
+       Random walk of the closes, with random wicks.
+    */
+    void GenerateBars(std::vector<Core::Bar>& bars)
+    {
+        float price = 1.3f;
+        for (unsigned int i = 0; i < NbBars; ++i)
+        {
+            float open = price;
+            price += (std::rand() % 201 - 100) * 0.00001f;
+            float high = std::max(open, price) + (std::rand() % 20) * 0.00001f;
+            float low = std::min(open, price) - (std::rand() % 20) * 0.00001f;
+            bars.push_back(Core::Bar(open, high, low, price, i * 5 * 60, true));
+        }
+    }
+}
+
+/*
+   Compares the ComputeSeries() of every indicator with the outputs of the indicator fed bar by bar,
+   for a few parameter sets: the values must be identical from the same first valid bar on.
+*/
+int main()
+{
+    Tickbench::Logger logger;
+    Core::Feedback feedback(false);
+    Tickbench::StratParams stratParams(logger);
+    Core::StrategyInstantiator strategyInstantiator(logger, feedback, stratParams);
+    if (!strategyInstantiator.Instantiate("MaCross", "EURUSD", 5, 5))
+    {
+        logger.Log("Failed to instantiate strategy \"MaCross\".", Logger::Error);
+        return boost::exit_failure;
+    }
+    Core::Strategy::Strategy& strategy = *strategyInstantiator.GetStrategy();
+
+    std::srand(42);
+    std::vector<Core::Bar> bars;
+    GenerateBars(bars);
+    std::vector<float> highs;
+    std::vector<float> lows;
+    std::vector<float> closes;
+    Core::Indicator::Indicator::GetColumn(bars, &Core::Bar::h, highs);
+    Core::Indicator::Indicator::GetColumn(bars, &Core::Bar::l, lows);
+    Core::Indicator::Indicator::GetColumn(bars, &Core::Bar::c, closes);
+
+    std::vector<Check> checks;
+    checks.reserve(32);
+    unsigned int const periods[] = { 2, 14, 100 };
+    for (unsigned int i = 0; i < sizeof(periods) / sizeof(*periods); ++i)
+    {
+        unsigned int period = periods[i];
+        std::string suffix = "(" + Tools::ToString(period) + ")";
+        {
+            Check& c = AddCheck(checks, "MovingAverage" + suffix, new Core::Indicator::MovingAverage(strategy, period, stratParams));
+            c.firstValid = Core::Indicator::MovingAverage::ComputeSeries(closes, period, c.series[0]);
+        }
+        {
+            Check& c = AddCheck(checks, "ExponentialMovingAverage" + suffix, new Core::Indicator::ExponentialMovingAverage(strategy, period));
+            c.firstValid = Core::Indicator::ExponentialMovingAverage::ComputeSeries(closes, period, c.series[0]);
+        }
+        {
+            Check& c = AddCheck(checks, "RelativeStrengthIndex" + suffix, new Core::Indicator::RelativeStrengthIndex(strategy, period));
+            c.firstValid = Core::Indicator::RelativeStrengthIndex::ComputeSeries(closes, period, c.series[0]);
+        }
+        {
+            Check& c = AddCheck(checks, "AverageTrueRange" + suffix, new Core::Indicator::AverageTrueRange(strategy, period));
+            c.firstValid = Core::Indicator::AverageTrueRange::ComputeSeries(highs, lows, closes, period, c.series[0]);
+        }
+        {
+            Check& c = AddCheck(checks, "BollingerBands" + suffix, new Core::Indicator::BollingerBands(strategy, period, 2));
+            c.firstValid = Core::Indicator::BollingerBands::ComputeSeries(closes, period, 2, c.series[0], c.series[1], c.series[2]);
+        }
+        {
+            Check& c = AddCheck(checks, "Macd" + suffix, new Core::Indicator::Macd(strategy, period, period * 2, 9));
+            c.firstValid = Core::Indicator::Macd::ComputeSeries(closes, period, period * 2, 9, c.series[0], c.series[1], c.series[2]);
+        }
+        {
+            Check& c = AddCheck(checks, "Stochastic" + suffix, new Core::Indicator::Stochastic(strategy, period, 3, 3));
+            c.firstValid = Core::Indicator::Stochastic::ComputeSeries(highs, lows, closes, period, 3, 3, c.series[0], c.series[1]);
+        }
+    }
+
+    // the same bars, one by one
+    Core::BarWindow window(Core::Signal::Signal::MaxBars);
+    {
+        std::vector<Check>::iterator it = checks.begin();
+        std::vector<Check>::iterator itEnd = checks.end();
+        for (; it != itEnd; ++it)
+            it->indicator->SetBars(window);
+    }
+    for (unsigned int bar = 0; bar < NbBars; ++bar)
+    {
+        window.Push(bars[bar]);
+        std::vector<Check>::iterator it = checks.begin();
+        std::vector<Check>::iterator itEnd = checks.end();
+        for (; it != itEnd; ++it)
+        {
+            it->indicator->NotifyBarAdded(bars[bar]);
+            it->indicator->Run();
+            if (it->indicator->IsValid() != (bar >= it->firstValid))
+                ++it->nbMismatches;
+            else if (it->indicator->IsValid())
+                for (unsigned int output = 0; output < it->series.size(); ++output)
+                    if (it->indicator->GetOutput(output) != it->series[output][bar])
+                        ++it->nbMismatches;
+        }
+    }
+
+    unsigned int nbFailed = 0;
+    {
+        std::vector<Check>::iterator it = checks.begin();
+        std::vector<Check>::iterator itEnd = checks.end();
+        for (; it != itEnd; ++it)
+        {
+            if (it->nbMismatches)
+            {
+                logger.Log(it->name + ": " + Tools::ToString(it->nbMismatches) + " mismatches.", Logger::Error);
+                ++nbFailed;
+            }
+            else
+                logger.Log(it->name + ": identical, first valid bar " + Tools::ToString(it->firstValid) + ".");
+            delete it->indicator;
+        }
+    }
+
+    // columns of different sizes give no valid output
+    {
+        std::vector<float> shortLows(lows.begin(), lows.end() - 1);
+        std::vector<float> main;
+        std::vector<float> signal;
+        if (Core::Indicator::Stochastic::ComputeSeries(highs, shortLows, closes, 14, 3, 3, main, signal) != closes.size() ||
+                Core::Indicator::AverageTrueRange::ComputeSeries(highs, shortLows, closes, 14, main) != closes.size())
+        {
+            logger.Log("Columns of different sizes gave valid outputs.", Logger::Error);
+            ++nbFailed;
+        }
+    }
+
+    logger.Log(Tools::ToString(checks.size()) + " series checked on " + Tools::ToString(NbBars) + " bars, " + Tools::ToString(nbFailed) + " failed.");
+    return nbFailed ? boost::exit_failure : boost::exit_success;
+}
@@ -32,12 +32,7 @@
 namespace Server
 {
     Feedback::Feedback(bool isNeeded) :
-        Core::Feedback(), _isNeeded(isNeeded)
+        Core::Feedback(isNeeded)
     {
     }
-
-    bool Feedback::IsNeeded() const
-    {
-        return this->_isNeeded;
-    }
 }
@@ -39,9 +39,6 @@ namespace Server
     {
         public:
             explicit Feedback(bool isNeeded);
-            virtual bool IsNeeded() const;
-        private:
-            bool _isNeeded;
     };
 }
 
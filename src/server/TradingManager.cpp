@@ -51,6 +51,7 @@ namespace Server
         this->_logger = new Logger(this->_server.GetUi(), this->_server.GetConf().Read<bool>("coreLogToUi", true), this->_server.GetConf().Read<bool>("coreLogToStdOut", false));
         this->_logExporter = new LogExporter(*this->_logger);
         this->_feedback = new Feedback(this->_server.GetUi().IsGraphical());
+        Core::StrategyInstantiator::LoadPlugins(this->_server.GetConf().Read<std::string>("strategyPlugins", ""), *this->_logger);
         this->_stratParams = new Core::StratParamsConf(this->_server.GetConf().Read<std::string>("strategyParams", "strategy.lua"), *this->_logger);
         this->_strategyInstantiator = new Core::StrategyInstantiator(*this->_logger, *this->_feedback, *this->_stratParams);
         this->_logExporter->Start();
@@ -345,7 +346,7 @@ namespace Server
         this->_logger->Log(CLASS "Creating controller...");
         if (this->_strategyInstantiator->Instantiate(this->_server.GetConf().Read<std::string>("strategy", ""), pair, period, digits))
         {
-            this->_controller = new Core::Controller(*this->_strategyInstantiator->GetStrategy());
+            this->_controller = new Core::BasicController<>(*this->_strategyInstantiator->GetStrategy());
             this->_logger->Log(CLASS "Controller successfully created.");
             return true;
         }
@@ -32,7 +32,7 @@
 
 #include <boost/noncopyable.hpp>
 #include <QString>
-#include "core/Controller.hpp"
+#include "core/BasicController.hpp"
 
 namespace Packet
 {
@@ -85,7 +85,7 @@ namespace Server
             void _SendTickResponse();
             Server& _server;
             Core::StrategyInstantiator* _strategyInstantiator;
-            Core::Controller* _controller;
+            Core::BasicController<>* _controller;
             Logger* _logger;
             Feedback* _feedback;
             Core::StratParamsConf* _stratParams;
@@ -0,0 +1,73 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "MaCrossTrailingStop.hpp"
+#include "core/StratParams.hpp"
+#include "core/StrategyInstantiator.hpp"
+#include "core/signal/MaCross.hpp"
+#include "core/actor/TrailingStop.hpp"
+
+namespace Tickbench
+{
+    namespace
+    {
+        Core::StrategyRegistry::Registrar registrar("MaCrossTrailingStop", &Core::CreateStrategy<MaCrossTrailingStop>);
+    }
+
+    MaCrossTrailingStop::MaCrossTrailingStop(::Logger::Logger const& logger,
+            Core::Feedback& feedback,
+            std::string const& pair,
+            unsigned int period,
+            unsigned int digits,
+            Core::StratParams& stratParams) :
+        Core::Strategy::Strategy("MaCrossTrailingStop", logger, feedback, pair, period, digits),
+        _stratParams(stratParams)
+    {
+    }
+
+    bool MaCrossTrailingStop::Init()
+    {
+        this->_signal = new Core::Signal::MaCross(*this, this->_stratParams);
+        this->_actor = new Core::Actor::TrailingStop(*this, this->_stratParams);
+        return true;
+    }
+
+    bool MaCrossTrailingStop::Reset()
+    {
+        this->_signal->Reset(this->_stratParams);
+        this->_actor->Reset(this->_stratParams);
+        return true;
+    }
+
+    void MaCrossTrailingStop::Deinit()
+    {
+        delete this->_signal;
+        delete this->_actor;
+    }
+}
@@ -0,0 +1,63 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __TICKBENCH_MACROSSTRAILINGSTOP__
+#define __TICKBENCH_MACROSSTRAILINGSTOP__
+
+#include "core/strategy/Strategy.hpp"
+
+namespace Core
+{
+    class StratParams;
+}
+
+namespace Tickbench
+{
+    /*
+       The MaCross signal with the TrailingStop actor, so that the positions are also closed by the actor.
+    */
+    class MaCrossTrailingStop :
+        public Core::Strategy::Strategy
+    {
+        public:
+            explicit MaCrossTrailingStop(::Logger::Logger const& logger,
+                    Core::Feedback& feedback,
+                    std::string const& pair,
+                    unsigned int period,
+                    unsigned int digits,
+                    Core::StratParams& stratParams);
+            virtual bool Init();
+            virtual void Deinit();
+            virtual bool Reset();
+        private:
+            Core::StratParams& _stratParams;
+    };
+}
+
+#endif
@@ -0,0 +1,174 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstdlib>
+#include <boost/cstdlib.hpp>
+#include "Logger.hpp"
+#include "StratParams.hpp"
+#include "core/Feedback.hpp"
+#include "core/StrategyInstantiator.hpp"
+#include "core/BasicController.hpp"
+#include "core/strategy/Strategy.hpp"
+#include "core/signal/MaCross.hpp"
+#include "core/actor/DoNothing.hpp"
+#include "core/actor/TrailingStop.hpp"
+#include "tools/Allocations.hpp"
+#include "tools/Timer.hpp"
+#include "tools/ToString.hpp"
+
+namespace
+{
+    unsigned int const TicksPerBar = 5;
+    unsigned int const WarmUpTicks = 100000; // fills the bar windows and the moving averages
+    float const Spread = 0.0002f;
+
+    /*
+       Position opened by the orders of the controller, closed by its orders or by its SL/TP.
+    */
+    struct Position
+    {
+        Core::Controller::Status status;
+        float open;
+        float lots;
+        float sl;
+        float tp;
+    };
+
+    /*
+       Random walk of the bid, a new bar every TicksPerBar ticks. The orders are executed at the tick prices.
+    */
+    template <class ControllerType>
+    void RunTicks(ControllerType& controller, unsigned int nbTicks, unsigned int& tick, float& bid, Core::Bar& bar, Position& position, unsigned long& nbTrades)
+    {
+        for (unsigned int i = 0; i < nbTicks; ++i, ++tick)
+        {
+            bid += (std::rand() % 201 - 100) * 0.00001f;
+            float ask = bid + Spread;
+            bool newBar = tick % TicksPerBar == 0;
+            if (newBar)
+                bar = Core::Bar(bid, bid, bid, bid, (tick / TicksPerBar) * 5 * 60, true);
+            else
+            {
+                if (bid > bar.h)
+                    bar.h = bid;
+                if (bid < bar.l)
+                    bar.l = bid;
+                bar.c = bid;
+            }
+            // SL/TP hit: the controller sees the position closed with this tick
+            if ((position.status == Core::Controller::StatusBuy && (bid >= position.tp || bid <= position.sl)) ||
+                    (position.status == Core::Controller::StatusSell && (ask <= position.tp || ask >= position.sl)))
+            {
+                position.status = Core::Controller::StatusNothing;
+                ++nbTrades;
+            }
+            controller.ProcessTick(bar, ask, bid, position.status, newBar);
+            Core::Controller::Output const& o = controller.GetLastOutput();
+            if (position.status == Core::Controller::StatusNothing && (o.order == Core::Controller::OrderBuy || o.order == Core::Controller::OrderSell))
+            {
+                position.status = o.order == Core::Controller::OrderBuy ? Core::Controller::StatusBuy : Core::Controller::StatusSell;
+                position.open = o.order == Core::Controller::OrderBuy ? ask : bid;
+                position.lots = o.lots;
+                position.sl = o.sl;
+                position.tp = o.tp;
+                controller.ProcessTrade(position.status, position.open, position.lots, position.sl, position.tp, ask, bid);
+            }
+            else if (position.status != Core::Controller::StatusNothing && o.order == Core::Controller::OrderClose)
+            {
+                position.status = Core::Controller::StatusNothing;
+                ++nbTrades;
+                controller.ProcessTrade(position.status, 0, 0, 0, 0, ask, bid);
+            }
+        }
+    }
+
+    /*
+       Runs a strategy made of the MaCross signal and an actor of type ActorType, through the specialized
+       controller of the backtester (without feedback).
+       false -> The strategy could not be instantiated, no position was closed or the tick loop allocated.
+    */
+    template <class ActorType>
+    bool RunScenario(Tickbench::Logger const& logger, std::string const& name, unsigned int nbTicks)
+    {
+        Core::Feedback feedback(false);
+        Tickbench::StratParams stratParams(logger);
+        Core::StrategyInstantiator strategyInstantiator(logger, feedback, stratParams);
+        if (!strategyInstantiator.Instantiate(name, "EURUSD", 5, 5) ||
+                !dynamic_cast<ActorType*>(&strategyInstantiator.GetStrategy()->GetActor()))
+        {
+            logger.Log("Failed to instantiate strategy \"" + name + "\".", Logger::Error);
+            return false;
+        }
+        strategyInstantiator.GetStrategy()->GetActor().SetLogStartStop(false);
+        Core::BasicController<Core::Signal::MaCross, ActorType, false> controller(*strategyInstantiator.GetStrategy());
+
+        std::srand(42);
+        unsigned int tick = 0;
+        float bid = 1.3f;
+        Core::Bar bar;
+        Position position;
+        position.status = Core::Controller::StatusNothing;
+        unsigned long nbTrades = 0;
+        RunTicks(controller, WarmUpTicks, tick, bid, bar, position, nbTrades);
+
+        nbTrades = 0;
+        unsigned long nbAllocations = Tools::GetNbAllocations();
+        Tools::Timer timer;
+        RunTicks(controller, nbTicks, tick, bid, bar, position, nbTrades);
+        long elapsed = timer.ElapsedMs();
+        nbAllocations = Tools::GetNbAllocations() - nbAllocations;
+
+        logger.Log(name + ": " + Tools::ToString(nbTicks) + " ticks in " + Tools::ToString(elapsed) + " ms, " + Tools::ToString(nbTrades) + " trades, " + Tools::ToString(nbAllocations) + " allocations.");
+        if (!nbTrades)
+        {
+            logger.Log(name + ": no position was closed.", Logger::Error);
+            return false;
+        }
+        if (nbAllocations)
+        {
+            logger.Log(name + ": the tick loop allocated.", Logger::Error);
+            return false;
+        }
+        return true;
+    }
+}
+
+/*
+   Runs the MaCross signal over ticks with the DoNothing actor (positions closed by their SL/TP) and with the
+   TrailingStop actor (positions also closed by the actor), and fails if any heap allocation happened after the warm up.
+*/
+int main(int ac, char** av)
+{
+    Tickbench::Logger logger;
+    unsigned int nbTicks = ac > 1 ? std::strtoul(av[1], 0, 10) : 10000000;
+
+    bool success = RunScenario<Core::Actor::DoNothing>(logger, "MaCross", nbTicks);
+    success = RunScenario<Core::Actor::TrailingStop>(logger, "MaCrossTrailingStop", nbTicks) && success;
+    return success ? boost::exit_success : boost::exit_failure;
+}
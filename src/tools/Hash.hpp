@@ -0,0 +1,83 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __TOOLS_HASH__
+#define __TOOLS_HASH__
+
+#include <cstring>
+#include <string>
+#include <boost/cstdint.hpp>
+
+namespace Tools
+{
+    /*
+       64 bit FNV-1a hash, fed incrementally.
+    */
+    class Hash
+    {
+        public:
+            Hash() :
+                _value(14695981039346656037ULL)
+            {
+            }
+
+            Hash& Add(void const* data, std::size_t size)
+            {
+                unsigned char const* bytes = static_cast<unsigned char const*>(data);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    this->_value ^= bytes[i];
+                    this->_value *= 1099511628211ULL;
+                }
+                return *this;
+            }
+
+            Hash& Add(std::string const& value)
+            {
+                this->Add(static_cast<boost::uint64_t>(value.size())); // "ab" + "c" != "a" + "bc"
+                return this->Add(value.data(), value.size());
+            }
+
+            template <typename T>
+                Hash& Add(T value)
+                {
+                    return this->Add(&value, sizeof(value));
+                }
+
+            boost::uint64_t GetValue() const
+            {
+                return this->_value;
+            }
+
+        private:
+            boost::uint64_t _value;
+    };
+}
+
+#endif
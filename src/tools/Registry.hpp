@@ -0,0 +1,132 @@
+// The Open Trading Project - open-trading.org
+//
+// Copyright (c) 2011 Martin Tapia - martin.tapia@open-trading.org
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+//    * Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef __TOOLS_REGISTRY__
+#define __TOOLS_REGISTRY__
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include "Hash.hpp"
+
+namespace Tools
+{
+    /*
+       Factories (function pointers of type Factory) found by name, one registry per factory type.
+       They register themselves from the translation unit of what they create, with a static Registrar:
+           namespace
+           {
+               SomeRegistry::Registrar registrar("name", &SomeFactory);
+           }
+       The names are looked up by their hash (see Hash.hpp). A name registered twice keeps its first factory, the
+       rejected names are kept so that they can be reported once a logger exists (see GetRejectedNames()).
+       Registering is not thread safe: it happens during static initialization or when loading a plugin.
+    */
+    template <class Factory>
+    class Registry :
+        private boost::noncopyable
+    {
+        public:
+            class Registrar
+            {
+                public:
+                    Registrar(std::string const& name, Factory factory)
+                    {
+                        Registry::GetInstance().Register(name, factory);
+                    }
+            };
+
+            static Registry& GetInstance()
+            {
+                static Registry instance; // constructed on first use, whatever the order of static initialization
+                return instance;
+            }
+
+            /*
+               false -> The name (or its hash) is already registered, the factory is ignored and the name is added
+               to the rejected names.
+            */
+            bool Register(std::string const& name, Factory factory)
+            {
+                if (this->_factories.insert(std::make_pair(Hash().Add(name).GetValue(), std::make_pair(name, factory))).second)
+                    return true;
+                this->_rejectedNames.push_back(name);
+                return false;
+            }
+
+            /*
+               Names whose registration failed, in order.
+            */
+            std::vector<std::string> const& GetRejectedNames() const
+            {
+                return this->_rejectedNames;
+            }
+
+            /*
+               0 if the name is not registered.
+            */
+            Factory Find(std::string const& name) const
+            {
+                typename FactoryMap::const_iterator it = this->_factories.find(Hash().Add(name).GetValue());
+                if (it == this->_factories.end() || it->second.first != name)
+                    return 0;
+                return it->second.second;
+            }
+
+            /*
+               Registered names separated by ", " (for the logs).
+            */
+            std::string GetNamesString() const
+            {
+                std::string names;
+                typename FactoryMap::const_iterator it = this->_factories.begin();
+                typename FactoryMap::const_iterator itEnd = this->_factories.end();
+                for (; it != itEnd; ++it)
+                {
+                    if (!names.empty())
+                        names += ", ";
+                    names += it->second.first;
+                }
+                return names;
+            }
+
+        private:
+            typedef std::map<boost::uint64_t, std::pair<std::string, Factory> > FactoryMap;
+            Registry()
+            {
+            }
+            FactoryMap _factories;
+            std::vector<std::string> _rejectedNames;
+    };
+}
+
+#endif